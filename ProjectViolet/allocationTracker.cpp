@@ -0,0 +1,146 @@
+//
+//  allocationTracker.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "allocationTracker.hpp"
+#include "debug.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#ifndef NDEBUG
+namespace
+{
+    thread_local Uint64 tAllocationCount = 0;
+    
+    void* countedAllocate(size_t size)
+    {
+        tAllocationCount++;
+        
+        void *memory = std::malloc(size > 0 ? size : 1);
+        
+        if (memory == nullptr)
+            throw std::bad_alloc();
+        
+        return memory;
+    }
+    
+    void* countedAlignedAllocate(size_t size, std::align_val_t alignment)
+    {
+        tAllocationCount++;
+        
+        void *memory = nullptr;
+        size_t alignmentBytes = std::max(static_cast<size_t>(alignment), sizeof(void*));
+        
+        if (posix_memalign(&memory, alignmentBytes, size > 0 ? size : 1) != 0)
+            throw std::bad_alloc();
+        
+        return memory;
+    }
+}
+
+// Every other form of new and delete is built on these by the standard library
+void* operator new(size_t size)
+{
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+    return countedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return countedAlignedAllocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return countedAlignedAllocate(size, alignment);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+#endif
+
+namespace AllocationTracker
+{
+    Uint64 getThreadAllocationCount()
+    {
+        Uint64 count = 0;
+        
+        ON_DEBUG(count = tAllocationCount;)
+        
+        return count;
+    }
+    
+    ZeroAllocationScope::ZeroAllocationScope(const char *name, bool enabled) : mName(name), mStartCount(getThreadAllocationCount()), mEnabled(enabled)
+    {
+        
+    }
+    
+    ZeroAllocationScope::~ZeroAllocationScope()
+    {
+#ifndef NDEBUG
+        Uint64 allocations = getThreadAllocationCount() - mStartCount;
+        
+        if (mEnabled && allocations > 0)
+        {
+            LOG_MESSAGE(Error, "%s made %llu heap allocations where none were expected!", mName, static_cast<unsigned long long>(allocations))
+            
+            // Strict runs stop right at the offending frame so it can be inspected
+            if (SDL_getenv("VIOLET_STRICT_ALLOCATIONS") != nullptr)
+            {
+                Debug::flushLog();
+                
+                assert(allocations == 0);
+            }
+        }
+#endif
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  allocationTracker.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef allocationTracker_hpp
+#define allocationTracker_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+
+// Debug builds replace the global operator new to count heap allocations per thread
+namespace AllocationTracker
+{
+    // Returns how many times the calling thread has allocated through operator new, always 0 under NDEBUG
+    Uint64 getThreadAllocationCount();
+    
+    // Reports every heap allocation the calling thread makes while the scope is alive, a no-op under NDEBUG
+    class ZeroAllocationScope
+    {
+    public:
+        // name must outlive the scope (a string literal), a disabled scope checks nothing
+        ZeroAllocationScope(const char *name, bool enabled = true);
+        
+        // Logs an error, and fails an assertion when VIOLET_STRICT_ALLOCATIONS is set, if anything was allocated
+        ~ZeroAllocationScope();
+    
+    private:
+        const char *mName;
+        Uint64 mStartCount;
+        bool mEnabled;
+    };
+}
+
+#endif /* allocationTracker_hpp */
@@ -8,13 +8,26 @@
 
 #include <iostream>
 #include <SDL_image.h>
+#include <SDL_ttf.h>
 
+#include "allocationTracker.hpp"
 #include "application.hpp"
+#include "assetManager.hpp"
+#include "benchmark.hpp"
+#include "bitmapFont.hpp"
 #include "debug.hpp"
+#include "frameArena.hpp"
+#include "inputLatency.hpp"
+#include "packArchive.hpp"
+#include "pixelConversion.hpp"
+#include "profiler.hpp"
+#include "systems.hpp"
+#include "textCache.hpp"
+#include "textureResidency.hpp"
 
 using namespace Debug;
 
-Application::Application() : continueExecution(true), mRenderer(nullptr), mWindow(nullptr, SDL_DestroyWindow)
+Application::Application() : continueExecution(true), mUpdateInterval(1.0 / DEFAULT_UPDATE_RATE), mMaxFrameTime(0.25), mFrameRateCap(0), mPresentPolicy(PresentPolicy::VSync), mLowLatencyPacing(false), mRefreshPeriod(1.0 / DEFAULT_FRAME_RATE_CAP), mFrameWorkEstimate(0.0), mLastSubmit(0), mLateInputSampling(false), mPerformanceFrequency(SDL_GetPerformanceFrequency()), mHeadlessFrames(0), mBenchmarkMode(false), mAutosaveInterval(0.0), mLastAutosave(0), mLastEventCount(0), mRedrawOnChange(false), mFramePresented(true), mBackBuffer(nullptr, SDL_DestroyTexture), mRenderer(nullptr), mCamera({0, 0, WINDOW_WIDTH, WINDOW_HEIGHT}), mWindow(nullptr, SDL_DestroyWindow)
 {
     
 }
@@ -26,6 +39,34 @@ Application::~Application()
 
 void Application::free()
 {
+    // Complete the input recording so it can be replayed
+    mInputRecorder.stopRecording();
+    
+    // Let the last autosave finish writing
+    mSnapshotWriter.stop();
+    
+    // Stop decoding before the textures' renderer goes away, the workers finish the jobs they are running first
+    mJobSystem.stop();
+    mAssetLoader.stop();
+    
+    // The audio device has to be closed before SDL shuts down
+    mAudioEngine.stop();
+    
+    // Every thread that records profiler events has stopped, so the rings can be read without racing their writers
+    ON_DEBUG(if (Profiler::isCapturing()) Profiler::endCapture(SDL_getenv("VIOLET_PROFILE"));)
+    
+    // Cached textures belong to the renderer, so the cache must not outlive it
+    AssetManager::clearTextureCache();
+    FontCache::clearFontCache();
+    TextCache::clearTextCache();
+    mParticleSystem.clear();
+    mTileMap.free();
+    mBackBuffer = nullptr;
+    
+    // Nothing reads from the archives once every loader and cache is gone
+    AssetPack::unmountAll();
+    
+    TTF_Quit();
     IMG_Quit();
     SDL_Quit();
 }
@@ -40,14 +81,14 @@ bool Application::run()
         // Initializes SDL and its sub-libraries
         if (!initLibraries())
         {
-            logMessage("Failed to initialize application libraries!", IrrecoverableError, __LINE__, __FILE_NAME__);
+            LOG_MESSAGE(IrrecoverableError, "Failed to initialize application libraries!")
             runSuccess = false;
         }
         
         // Loads applications resources
         if (!loadMedia())
         {
-            logMessage("Failed to load application resources!", IrrecoverableError, __LINE__, __FILE_NAME__);
+            LOG_MESSAGE(IrrecoverableError, "Failed to load application resources!")
             runSuccess = false;
         }
     }
@@ -59,9 +100,39 @@ bool Application::run()
         stopApplication();
     }
     
-    mainLoop();
+    // Setting VIOLET_PROFILE to a file path captures the run as a Chrome trace
+    ON_DEBUG(if (SDL_getenv("VIOLET_PROFILE") != nullptr) Profiler::beginCapture();)
     
-    // Releases the library's resources
+    if (mBenchmarkMode)
+    {
+        // Only benchmark a fully initialized application
+        if (continueExecution && runSuccess)
+            runSuccess = Benchmark::runSuite(mRenderer, mBenchmarkOutput);
+    }
+    else
+    {
+        mainLoop();
+    }
+    
+    // Report how the headless run went as a line of JSON
+    if (mHeadlessFrames > 0 && !mBenchmarkMode)
+        Benchmark::writeResult(std::cout, "headless_frame_time", static_cast<int>(mFrameTimes.size()), Benchmark::computeStatistics(mFrameTimes));
+    
+    // Latency is only measured on frames that showed new input
+    if (InputLatency::getSampleCount() > 0)
+    {
+        Benchmark::TimingStatistics latency = InputLatency::getStatistics();
+        
+        LOG_MESSAGE(Information, "Input latency over %d frames: p50 %.0f ms, p99 %.0f ms, max %.0f ms", latency.samples, latency.p50, latency.p99, latency.maximum)
+        
+        if (mHeadlessFrames > 0 && !mBenchmarkMode)
+        {
+            Benchmark::writeResult(std::cout, "input_latency", 1, latency);
+            InputLatency::writeHistogram(std::cout, "input_latency");
+        }
+    }
+    
+    // Releases the library's resources, the profiler capture is written there once the threads recording into it are stopped
     free();
     
     return runSuccess;
@@ -74,39 +145,135 @@ void Application::stopApplication()
     continueExecution = false;
 }
 
+void Application::setUpdateRate(int updatesPerSecond)
+{
+    if (updatesPerSecond > 0)
+        mUpdateInterval = 1.0 / updatesPerSecond;
+}
+
+void Application::setFrameRateCap(int framesPerSecond)
+{
+    mFrameRateCap = framesPerSecond > 0 ? framesPerSecond : 0;
+}
+
+void Application::setMaxFrameTime(double seconds)
+{
+    if (seconds > 0.0)
+        mMaxFrameTime = seconds;
+}
+
+void Application::setHeadless(int frameCount)
+{
+    mHeadlessFrames = frameCount > 0 ? frameCount : 0;
+    mFrameTimes.reserve(mHeadlessFrames);
+}
+
+void Application::addPackArchive(std::string archivePath, std::string mountPoint)
+{
+    mPackArchives.emplace_back(archivePath, mountPoint);
+}
+
+void Application::setAutosave(std::string filePath, double intervalSeconds)
+{
+    mAutosavePath = filePath;
+    mAutosaveInterval = intervalSeconds > 0.0 ? intervalSeconds : 5.0;
+}
+
+void Application::setTextureBudget(size_t budgetBytes)
+{
+    TextureResidency::setBudget(budgetBytes);
+}
+
+void Application::setPremultipliedAlpha(bool premultiply)
+{
+    PixelConversion::setPremultiplyAlpha(premultiply);
+}
+
+void Application::setRedrawOnChange(bool redrawOnChange)
+{
+    mRedrawOnChange = redrawOnChange;
+}
+
+void Application::setInputRecording(std::string filePath)
+{
+    mInputRecordingPath = filePath;
+}
+
+bool Application::setReplay(std::string filePath)
+{
+    if (!mInputRecorder.loadReplay(filePath))
+        return false;
+    
+    // Stepping at a different rate than the recording would put the same input on different updates
+    mUpdateInterval = mInputRecorder.getReplayUpdateInterval();
+    
+    setHeadless(mInputRecorder.getReplayFrameCount());
+    
+    return true;
+}
+
+void Application::setPresentPolicy(PresentPolicy presentPolicy)
+{
+    mPresentPolicy = presentPolicy;
+}
+
+void Application::setLateInputSampling(bool lateInputSampling)
+{
+    mLateInputSampling = lateInputSampling;
+}
+
+void Application::markDirty(const SDL_Rect &rect)
+{
+    mDirtyRegions.mark(rect);
+}
+
+void Application::setBenchmarkMode(std::string outputPath)
+{
+    mBenchmarkMode = true;
+    mBenchmarkOutput = outputPath;
+    
+    // The benchmarks never show a window either
+    if (mHeadlessFrames == 0)
+        setHeadless(1);
+}
+
 bool Application::initLibraries()
 {
     bool success = true;
     
+    // Headless runs use the dummy video driver unless SDL_VIDEODRIVER picks something else
+    if (mHeadlessFrames > 0)
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    
     // Initialize SDL with video and audio channels extensions enabled
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0)
     {
-        ON_DEBUG(logMessage("Failed to initialize SDL!", SevereError, __LINE__, __FILE_NAME__);)
-        ON_DEBUG(logMessage(SDL_GetError(), SDLError, __LINE__, __FILE_NAME__);)
+        LOG_MESSAGE(SevereError, "Failed to initialize SDL!")
+        LOG_MESSAGE(SDLError, "%s", SDL_GetError())
         
         success = false;
     }
     else
     {
         // Create an SDL window unique pointer with custom deleter
-        mWindow = std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)>(SDL_CreateWindow("Project Violet", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN), &SDL_DestroyWindow);
+        mWindow = std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)>(SDL_CreateWindow("Project Violet", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WINDOW_WIDTH, WINDOW_HEIGHT, mHeadlessFrames > 0 ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN), &SDL_DestroyWindow);
         
         if (mWindow == nullptr)
         {
-            ON_DEBUG(logMessage("Failed to create the application's window!", SevereError, __LINE__, __FILE_NAME__);)
-            ON_DEBUG(logMessage(SDL_GetError(), SDLError, __LINE__, __FILE_NAME__);)
+            LOG_MESSAGE(SevereError, "Failed to create the application's window!")
+            LOG_MESSAGE(SDLError, "%s", SDL_GetError())
             
             success = false;
         }
         else
         {
             // Create an SDL Renderer shared pointer with custom deleter
-            mRenderer = std::shared_ptr<SDL_Renderer>(SDL_CreateRenderer(mWindow.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC), &SDL_DestroyRenderer);
+            mRenderer = std::shared_ptr<SDL_Renderer>(SDL_CreateRenderer(mWindow.get(), -1, mHeadlessFrames > 0 ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED | (mPresentPolicy != PresentPolicy::Immediate ? SDL_RENDERER_PRESENTVSYNC : 0)), &SDL_DestroyRenderer);
             
             if (mRenderer == nullptr)
             {
-                ON_DEBUG(logMessage("Failed to create the application's renderer!", SevereError, __LINE__, __FILE_NAME__);)
-                ON_DEBUG(logMessage(SDL_GetError(), SDLError, __LINE__, __FILE_NAME__);)
+                LOG_MESSAGE(SevereError, "Failed to create the application's renderer!")
+                LOG_MESSAGE(SDLError, "%s", SDL_GetError())
                 
                 success = false;
             }
@@ -114,17 +281,78 @@ bool Application::initLibraries()
             {
                 SDL_SetRenderDrawColor(mRenderer.get(), 0xFF, 0xFF, 0xFF, 0xFF);
                 
+                // Premultiplied textures drawn with plain blending get dark edges, so keep them straight instead
+                if (PixelConversion::isPremultiplyingAlpha() && !PixelConversion::supportsPremultipliedBlendMode(mRenderer.get()))
+                {
+                    LOG_MESSAGE(Warning, "The renderer has no premultiplied blending, textures will keep straight alpha!")
+                    
+                    PixelConversion::setPremultiplyAlpha(false);
+                }
+                
+                if (mRedrawOnChange)
+                    createBackBuffer();
+                
+                SDL_RendererInfo rendererInfo;
+                
+                // Without vsync (dummy or software renderers) nothing paces the loop, so cap it rather than spin a core,
+                // headless runs are measuring the loop and stay uncapped unless asked otherwise
+                if (mFrameRateCap == 0 && mHeadlessFrames == 0 && SDL_GetRendererInfo(mRenderer.get(), &rendererInfo) == 0 && !(rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC))
+                    setFrameRateCap(DEFAULT_FRAME_RATE_CAP);
+                
+                SDL_DisplayMode displayMode;
+                
+                // Low latency pacing needs to know how long a refresh is, displays that don't say are assumed to run at 60 Hz
+                if (SDL_GetWindowDisplayMode(mWindow.get(), &displayMode) == 0 && displayMode.refresh_rate > 0)
+                    mRefreshPeriod = 1.0 / displayMode.refresh_rate;
+                
+                // A renderer that can't vsync was given a frame cap above, which paces the loop instead
+                mLowLatencyPacing = mPresentPolicy == PresentPolicy::LowLatency && mFrameRateCap == 0 && mHeadlessFrames == 0;
+                
+                // Archives are mounted before any loader thread can read from them
+                for (std::pair<std::string, std::string> &packArchive : mPackArchives)
+                {
+                    if (!AssetPack::mount(packArchive.first, packArchive.second))
+                        LOG_MESSAGE(SevereWarning, "Failed to mount %s, its assets will be read from disk!", packArchive.first.c_str())
+                }
+                
+                mJobSystem.start();
+                
+                // Images decode as background jobs, so they never hold up a frame's work
+                mAssetLoader.setDecodeScheduler([this](std::function<void()> decodeJob)
+                {
+                    mJobSystem.runBackground(decodeJob);
+                });
+                
+                // Background image decoding needs the renderer for its uploads
+                mAssetLoader.start(mRenderer);
+                
+                if (!mAutosavePath.empty())
+                    mSnapshotWriter.start();
+                
                 // IMG flags have to be stored to check against IMG_INIT(...)
                 int imgFlags = IMG_INIT_JPG | IMG_INIT_PNG;
                 
                 // Initialize SDL_image library with JPEG and PNG support
                 if (!(IMG_Init(imgFlags) & imgFlags))
                 {
-                    ON_DEBUG(logMessage("Failed to initialize SDL_image!", SevereError, __LINE__, __FILE_NAME__);)
-                    ON_DEBUG(logMessage(IMG_GetError(), SDLImageError, __LINE__, __FILE_NAME__);)
+                    LOG_MESSAGE(SevereError, "Failed to initialize SDL_image!")
+                    LOG_MESSAGE(SDLImageError, "%s", IMG_GetError())
+                    
+                    success = false;
+                }
+                
+                // Initialize SDL_ttf for the bitmap font system
+                if (TTF_Init() == -1)
+                {
+                    LOG_MESSAGE(SevereError, "Failed to initialize SDL_ttf!")
+                    LOG_MESSAGE(SDLFontError, "%s", TTF_GetError())
                     
                     success = false;
                 }
+                
+                // Missing audio hardware shouldn't stop the game, it just runs silent
+                if (!mAudioEngine.start())
+                    LOG_MESSAGE(Warning, "Failed to start the audio engine, continuing without sound!")
             }
         }
     }
@@ -136,43 +364,349 @@ bool Application::loadMedia()
 {
     bool success = true;
     
+    // Pick up where the last autosave left off, a missing save just starts fresh
+    SDL_RWops *saveFile = mAutosavePath.empty() ? nullptr : SDL_RWFromFile(mAutosavePath.c_str(), "rb");
+    
+    if (saveFile != nullptr)
+    {
+        SDL_RWclose(saveFile);
+        
+        WorldSnapshot snapshot;
+        
+        if (SaveState::readSnapshot(mAutosavePath, snapshot))
+            SaveState::restoreSnapshot(snapshot, mRegistry);
+        
+        mRegistry.flushDeferred();
+    }
+    
+    mLastAutosave = SDL_GetPerformanceCounter();
+    
     return success;
 }
 
 void Application::mainLoop()
 {
+    // Simulation time that has passed but not been stepped through yet
+    double accumulator = 0.0;
+    
+    Uint64 previousCounter = SDL_GetPerformanceCounter();
+    
+    Uint64 frameCount = 0;
+    
+    if (!mInputRecordingPath.empty())
+        mInputRecorder.startRecording(mInputRecordingPath, mUpdateInterval);
+    
     // Loops as long as the execution flag remains true
     while (continueExecution)
     {
+        PROFILE_ZONE("Application::mainLoop")
+        
+        // Scratch data from the last frame is no longer needed
+        FrameMemory::beginFrame();
+        
+        // Textures that haven't been drawn in a while make room before this frame can reload anything
+        TextureResidency::beginFrame();
+        
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        
+        // Containers take a few frames to reach their steady size, after that updating and rendering mustn't allocate
+        bool steadyState = ++frameCount > ALLOCATION_WARMUP_FRAMES;
+        
+        double frameTime = static_cast<double>(frameStart - previousCounter) / mPerformanceFrequency;
+        previousCounter = frameStart;
+        
+        // Clamp long frames so a stall drops time instead of queuing more updates than can ever be caught up on
+        if (frameTime > mMaxFrameTime)
+            frameTime = mMaxFrameTime;
+        
+        // Recorded after clamping, so a replay feeds the accumulator exactly what this run did
+        mInputRecorder.beginFrame(frameTime);
+        
+        accumulator += frameTime;
+        
+        mLastEventCount = 0;
+        
         handleInput();
         
-        update();
+        // Step the simulation at a fixed rate no matter how fast frames are presented
+        {
+            AllocationTracker::ZeroAllocationScope updateAllocations("Application::update", steadyState);
+            
+            while (accumulator >= mUpdateInterval)
+            {
+                update(mUpdateInterval);
+                
+                accumulator -= mUpdateInterval;
+            }
+        }
+        
+        // Only the capture happens here, if the last save is still being written this one waits for the next frame
+        if (!mAutosavePath.empty() && static_cast<double>(frameStart - mLastAutosave) / mPerformanceFrequency >= mAutosaveInterval)
+        {
+            if (mSnapshotWriter.saveAsync(mRegistry, mAutosavePath))
+                mLastAutosave = frameStart;
+        }
+        
+        // Turn images decoded in the background into textures, without letting it eat the frame
+        mAssetLoader.processUploads(TEXTURE_UPLOAD_BUDGET);
+        
+        // Input that arrived while the simulation stepped is handled now, so this frame shows it rather than the next one
+        if (mLateInputSampling)
+            handleInput();
+        
+        // Render between the last two updates using the leftover time
+        {
+            AllocationTracker::ZeroAllocationScope renderAllocations("Application::renderFrame", steadyState);
+            
+            renderFrame(accumulator / mUpdateInterval);
+        }
+        
+        // Nothing changed on screen and nothing happened, so sleep until something does instead of checking again right away,
+        // headless runs are timing the loop and never go idle
+        if (mRedrawOnChange && !mFramePresented && mLastEventCount == 0 && mAssetLoader.getPendingCount() == 0 && mHeadlessFrames == 0)
+        {
+            PROFILE_ZONE("Application::waitForEvent")
+            
+            SDL_WaitEventTimeout(nullptr, IDLE_WAIT_TIMEOUT);
+        }
+        else if (mFrameRateCap > 0)
+        {
+            PROFILE_ZONE("Application::waitForNextFrame")
+            
+            waitForNextFrame(frameStart);
+        }
+        else if (mLowLatencyPacing && mFramePresented)
+        {
+            PROFILE_ZONE("Application::waitForLateStart")
+            
+            waitForLateStart(frameStart);
+        }
+        
+        // Headless runs record each frame's time and stop after the requested number of frames
+        if (mHeadlessFrames > 0)
+        {
+            mFrameTimes.push_back(static_cast<double>(SDL_GetPerformanceCounter() - frameStart) / mPerformanceFrequency);
+            
+            if (static_cast<int>(mFrameTimes.size()) >= mHeadlessFrames)
+                stopApplication();
+        }
+    }
+}
 
-        renderFrame();
+void Application::waitForNextFrame(Uint64 frameStart)
+{
+    // SDL_Delay can oversleep by a couple of milliseconds, so the last stretch is spun instead
+    const double spinThreshold = 0.002;
+    
+    Uint64 frameEnd = frameStart + mPerformanceFrequency / mFrameRateCap;
+    Uint64 now = SDL_GetPerformanceCounter();
+    
+    if (now >= frameEnd)
+        return;
+    
+    double remaining = static_cast<double>(frameEnd - now) / mPerformanceFrequency;
+    
+    if (remaining > spinThreshold)
+        SDL_Delay(static_cast<Uint32>((remaining - spinThreshold) * 1000.0));
+    
+    while (SDL_GetPerformanceCounter() < frameEnd)
+    {
+        // Spin until the frame's time slice is used up
     }
 }
 
+void Application::waitForLateStart(Uint64 frameStart)
+{
+    double work = static_cast<double>(mLastSubmit - frameStart) / mPerformanceFrequency;
+    
+    // Follows a longer frame right away but only slowly trusts shorter ones, one slow frame costs a whole refresh
+    mFrameWorkEstimate = work > mFrameWorkEstimate ? work : mFrameWorkEstimate * 0.98 + work * 0.02;
+    
+    // The present just returned at vblank, so the next frame has one refresh to be sampled, stepped and drawn
+    double delay = mRefreshPeriod - mFrameWorkEstimate - LOW_LATENCY_MARGIN;
+    
+    // SDL_Delay only has millisecond precision, anything shorter isn't worth the oversleep
+    if (delay >= 0.001)
+        SDL_Delay(static_cast<Uint32>(delay * 1000.0));
+}
+
 void Application::handleInput()
 {
-    // Gets the most recent event in the SDL event queue
-    while (SDL_PollEvent(&mEvent))
+    PROFILE_ZONE("Application::handleInput")
+    
+    // Gets the most recent event in the SDL event queue, or the recorded one when replaying
+    while (mInputRecorder.pollEvent(mEvent))
     {
+        mLastEventCount++;
+        
+        // The oldest input the next present shows is what the player waited on
+        if (InputLatency::isInputEvent(mEvent))
+            InputLatency::recordInput(mEvent.common.timestamp);
+        
         // If the user performs some form of QUIT operation, stop further application operation
         if (mEvent.type == SDL_QUIT)
             stopApplication();
+        
+        // Target textures lose their contents when the device is reset, so the tile chunks are baked again
+        if (mEvent.type == SDL_RENDER_TARGETS_RESET || mEvent.type == SDL_RENDER_DEVICE_RESET)
+        {
+            mTileMap.invalidateChunks();
+            mDirtyRegions.markAll();
+        }
+        
+        // A lost device takes the back buffer's texture with it, not just its contents
+        if (mEvent.type == SDL_RENDER_DEVICE_RESET && mRedrawOnChange)
+            createBackBuffer();
+        
+        // The window's contents may have been lost while it was covered, the back buffer still has the whole frame
+        if (mEvent.type == SDL_WINDOWEVENT && mEvent.window.event == SDL_WINDOWEVENT_EXPOSED)
+            mDirtyRegions.markAll();
     }
 }
 
-void Application::update()
+void Application::update(double deltaTime)
 {
+    PROFILE_ZONE("Application::update")
     
+    Systems::storePreviousTransforms(mRegistry, mJobSystem);
+    Systems::integrateMovement(mRegistry, deltaTime, mJobSystem);
+    
+    mParticleSystem.update(deltaTime);
+    
+    // Entities created or destroyed by the systems only take effect once every system has run
+    mRegistry.flushDeferred();
+    
+    // Contacts are found after movement, so whatever responds to them sees where everything ended up
+    Systems::updateColliders(mRegistry, mCollisionWorld);
+    mCollisionWorld.findContacts();
+    
+    // Done last so the index sees this update's positions and entities
+    Systems::updateSpatialIndex(mRegistry, mSpatialIndex);
+}
+
+void Application::renderFrame(double interpolation)
+{
+    PROFILE_ZONE("Application::renderFrame")
+    
+    // Sprites queued during the frame are collected here and drawn page by page
+    mSpriteBatch.begin(mRenderer);
+    
+    // Only the tile chunks in view are drawn, any that changed are baked first
+    mTileMap.queue(mRenderQueue, mCamera, TILE_MAP_LAYER);
+    
+    Systems::renderSprites(mRegistry, mSpatialIndex, mRenderQueue, mCamera, interpolation);
+    
+    if (mRedrawOnChange)
+    {
+        renderDirtyRegions(interpolation);
+    }
+    else
+    {
+        SDL_SetRenderDrawColor(mRenderer.get(), 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(mRenderer.get());
+        
+        // Draw commands recorded during the frame go out sorted, followed by the batched sprites
+        mRenderQueue.flush(mRenderer);
+        mSpriteBatch.flush();
+        
+        // Particles are stepped with the simulation, so they are carried on by the time since the last update
+        mParticleSystem.render(mRenderer.get(), mCamera, static_cast<float>(interpolation * mUpdateInterval));
+        
+        presentFrame();
+    }
+    
+    PROFILE_COUNTER("Batched sprites", mSpriteBatch.getLastSpriteCount())
+    PROFILE_COUNTER("Sprite batches", mSpriteBatch.getLastBatchCount())
 }
 
-void Application::renderFrame()
+void Application::renderDirtyRegions(double interpolation)
 {
+    PROFILE_ZONE("Application::renderDirtyRegions")
+    
+    // Baked chunks change what a chunk command shows without changing the command, batched sprites and particles keep
+    // no history, and particles drawn last frame have to be erased even once they are all gone
+    if (mTileMap.getLastBakeCount() > 0 || mSpriteBatch.getPendingSpriteCount() > 0 || mParticleSystem.getLiveCount() > 0 || mParticleSystem.getLastDrawnCount() > 0)
+        mDirtyRegions.markAll();
+    
+    mRenderQueue.collectChanges(mDirtyRegions);
+    
+    // The window's contents aren't kept between presents, so without a back buffer any change redraws everything
+    if (!mBackBuffer && mDirtyRegions.isDirty())
+        mDirtyRegions.markAll();
+    
+    mFramePresented = mDirtyRegions.isDirty();
+    
+    if (!mFramePresented)
+    {
+        mRenderQueue.clear();
+        
+        // Input that changed nothing on screen has no latency, waiting for whatever present comes next would count idle time
+        InputLatency::dropPendingInput();
+        
+        return;
+    }
+    
+    const std::vector<SDL_Rect> &regions = mDirtyRegions.getRegions();
+    
+    // Everything outside the regions is left as it was drawn in earlier frames
+    SDL_SetRenderTarget(mRenderer.get(), mBackBuffer.get());
     SDL_SetRenderDrawColor(mRenderer.get(), 0xFF, 0xFF, 0xFF, 0xFF);
-    SDL_RenderClear(mRenderer.get());
+    SDL_SetRenderDrawBlendMode(mRenderer.get(), SDL_BLENDMODE_NONE);
+    
+    for (const SDL_Rect &region : regions)
+        SDL_RenderFillRect(mRenderer.get(), &region);
+    
+    mRenderQueue.flush(mRenderer, &regions);
+    mSpriteBatch.flush();
+    mParticleSystem.render(mRenderer.get(), mCamera, static_cast<float>(interpolation * mUpdateInterval));
+    
+    if (mBackBuffer)
+    {
+        SDL_SetRenderTarget(mRenderer.get(), nullptr);
+        SDL_RenderCopy(mRenderer.get(), mBackBuffer.get(), nullptr, nullptr);
+    }
+    
+    PROFILE_COUNTER("Dirty regions", regions.size())
+    
+    presentFrame();
+    
+    mDirtyRegions.clear();
+}
+
+void Application::createBackBuffer()
+{
+    int width = WINDOW_WIDTH, height = WINDOW_HEIGHT;
+    
+    SDL_GetRendererOutputSize(mRenderer.get(), &width, &height);
+    
+    // Without a back buffer every changed frame is drawn in full straight to the window
+    mDirtyRegions.setBounds(width, height);
+    
+    if (!SDL_RenderTargetSupported(mRenderer.get()))
+        return;
+    
+    mBackBuffer.reset(SDL_CreateTexture(mRenderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height));
+    
+    if (!mBackBuffer)
+    {
+        LOG_MESSAGE(Warning, "Failed to create the back buffer, changed frames will be redrawn in full!")
+        LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+        
+        return;
+    }
+    
+    // Copied over the whole window each frame, so nothing underneath should show through
+    SDL_SetTextureBlendMode(mBackBuffer.get(), SDL_BLENDMODE_NONE);
+}
+
+void Application::presentFrame()
+{
+    PROFILE_ZONE("SDL_RenderPresent")
+    
+    mLastSubmit = SDL_GetPerformanceCounter();
     
     SDL_RenderPresent(mRenderer.get());
-    SDL_RenderClear(mRenderer.get());
+    
+    // With vsync this returns once the frame is on its way to the display
+    InputLatency::recordPresent();
 }
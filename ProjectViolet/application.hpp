@@ -12,10 +12,39 @@
 #include <memory>
 #include <SDL.h>
 #include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "assetLoader.hpp"
+#include "audioEngine.hpp"
+#include "collisionWorld.hpp"
+#include "dirtyRegions.hpp"
+#include "entityRegistry.hpp"
+#include "inputRecorder.hpp"
+#include "jobSystem.hpp"
+#include "particleSystem.hpp"
+#include "renderQueue.hpp"
+#include "saveState.hpp"
+#include "spatialHash.hpp"
+#include "spriteBatch.hpp"
+#include "tileMap.hpp"
 
 class Application
 {
 public:
+    // How frames are paced against the display
+    enum class PresentPolicy
+    {
+        // Presents wait for vblank, the frame is sampled a whole refresh before it's shown
+        VSync,
+        
+        // Presents wait for vblank, but the next frame starts as late as it can and still make the following one
+        LowLatency,
+        
+        // Presents never wait, lowest latency at the cost of tearing
+        Immediate
+    };
+    
     // Initialize application variables
     Application();
     
@@ -31,6 +60,51 @@ public:
     // Sets the application to stop at the end of its iteration
     void stopApplication();
     
+    // Sets how many fixed simulation steps run per second
+    void setUpdateRate(int updatesPerSecond);
+    
+    // Limits how many frames are presented per second, 0 leaves the frame rate to vsync
+    void setFrameRateCap(int framesPerSecond);
+    
+    // Runs without a visible window on SDL's dummy video driver and software renderer, stopping after frameCount frames
+    void setHeadless(int frameCount);
+    
+    // Runs the micro-benchmark suite headlessly instead of the main loop, results go to the file (stdout if empty)
+    void setBenchmarkMode(std::string outputPath);
+    
+    // Sets the longest frame the simulation will try to catch up on before dropping time
+    void setMaxFrameTime(double seconds);
+    
+    // Reads assets under mountPoint from a pack archive instead of the file system, archives added later take precedence
+    void addPackArchive(std::string archivePath, std::string mountPoint);
+    
+    // Resumes from the save file if it exists, then saves the world to it every intervalSeconds in the background
+    void setAutosave(std::string filePath, double intervalSeconds);
+    
+    // Evicts the least recently drawn textures whenever more than budgetBytes of them are resident, zero disables the budget
+    void setTextureBudget(size_t budgetBytes);
+    
+    // Premultiplies alpha when image textures are uploaded, sprites drawing them need the premultiplied blend mode
+    void setPremultipliedAlpha(bool premultiply);
+    
+    // Only redraws the parts of the screen that changed, and sleeps until an event arrives while nothing does
+    void setRedrawOnChange(bool redrawOnChange);
+    
+    // Records every frame's input and frame time to the file, to be replayed with setReplay
+    void setInputRecording(std::string filePath);
+    
+    // Replays a recording headlessly in place of real input, running exactly its frames with its frame times and update rate
+    bool setReplay(std::string filePath);
+    
+    // Sets how presents are paced, must be called before the renderer is created
+    void setPresentPolicy(PresentPolicy presentPolicy);
+    
+    // Polls input a second time after the simulation steps, right before the frame's draw commands are built
+    void setLateInputSampling(bool lateInputSampling);
+    
+    // Marks part of the screen for redrawing, for changes the render queue can't see, only used when redrawing on change
+    void markDirty(const SDL_Rect &rect);
+    
     // Starts the application and runs the main loop
     bool initLibraries();
     
@@ -40,24 +114,155 @@ public:
     // Polls SDL for game input
     void handleInput();
     
-    // Renders a single frame to the screen
-    void renderFrame();
+    // Renders a single frame to the screen, interpolation is how far (0-1) the frame is between the last two updates
+    void renderFrame(double interpolation);
     
-    // Updates the game by one iteration
-    void update();
+    // Updates the game by one fixed step of deltaTime seconds
+    void update(double deltaTime);
     
     // Contains the main game loop
     void mainLoop();
     
     static const int WINDOW_WIDTH = 750, WINDOW_HEIGHT = 750;
     
+    // Main thread time each frame may spend uploading textures decoded in the background
+    static constexpr double TEXTURE_UPLOAD_BUDGET = 0.004;
+    
+    // Render queue layer of the tile map, below every sprite
+    static const int TILE_MAP_LAYER = -1000;
+    
+    // Longest an idle loop sleeps waiting for an event, short enough that fixed updates never lose time to the frame clamp
+    static const int IDLE_WAIT_TIMEOUT = 100;
+    
+    // Time left between the end of a low latency frame's work and vblank, to absorb frames that run a little long
+    static constexpr double LOW_LATENCY_MARGIN = 0.002;
+    
+    // Frames allowed to allocate while containers grow to their working size, after which debug builds check for allocations
+    static const Uint64 ALLOCATION_WARMUP_FRAMES = 120;
+    
+    // Simulation rate, and the frame cap used when the renderer can't vsync
+    static const int DEFAULT_UPDATE_RATE = 60, DEFAULT_FRAME_RATE_CAP = 60;
+    
 private:
+    // Redraws the dirty parts of the back buffer and presents it, or presents nothing if the frame didn't change
+    void renderDirtyRegions(double interpolation);
+    
+    // Creates the back buffer at the renderer's output size, leaving it empty if the renderer can't draw to textures
+    void createBackBuffer();
+    
+    // Shows the frame drawn to the window
+    void presentFrame();
+    
+    // Sleeps, then spins for the last stretch, until the frame that started at frameStart has used its time slice
+    void waitForNextFrame(Uint64 frameStart);
+    
+    // Sleeps after a vsynced present for as much of the refresh as the frame's work doesn't need, so input is sampled late
+    void waitForLateStart(Uint64 frameStart);
+    
     bool continueExecution;
     
+    // Length of one simulation step, in seconds
+    double mUpdateInterval;
+    
+    // Frame times above this are clamped so a long stall can't snowball into ever more updates
+    double mMaxFrameTime;
+    
+    // Presented frames per second, 0 when uncapped
+    int mFrameRateCap;
+    
+    PresentPolicy mPresentPolicy;
+    
+    // Set when the renderer vsyncs and the low latency policy was asked for
+    bool mLowLatencyPacing;
+    
+    // Length of one display refresh, and a slowly decaying peak of the work done before each present, in seconds
+    double mRefreshPeriod;
+    double mFrameWorkEstimate;
+    
+    // Performance counter when the last frame was handed to SDL_RenderPresent
+    Uint64 mLastSubmit;
+    
+    // Set when input is polled again right before rendering
+    bool mLateInputSampling;
+    
+    // Performance counter ticks per second
+    Uint64 mPerformanceFrequency;
+    
+    // Headless runs stop after this many frames, 0 when running normally
+    int mHeadlessFrames;
+    
+    // Frame times recorded during a headless run, in seconds
+    std::vector<double> mFrameTimes;
+    
+    // Set when the benchmark suite should run instead of the main loop
+    bool mBenchmarkMode;
+    std::string mBenchmarkOutput;
+    
+    // Archives to mount before any loader starts, as archive path and mount point
+    std::vector<std::pair<std::string, std::string>> mPackArchives;
+    
+    // Autosaving is off while the path is empty, mLastAutosave is in performance counter ticks
+    std::string mAutosavePath;
+    double mAutosaveInterval;
+    Uint64 mLastAutosave;
+    
     SDL_Event mEvent;
     
+    // Events are read through the recorder so sessions can be recorded and replayed, recording is off while the path is empty
+    InputRecorder mInputRecorder;
+    std::string mInputRecordingPath;
+    
+    // Number of events handled by the last handleInput(), the loop only goes idle after a frame without any
+    int mLastEventCount;
+    
+    // Set when the screen is only redrawn where something changed, mFramePresented is false after a frame with no changes
+    bool mRedrawOnChange;
+    bool mFramePresented;
+    
+    // Parts of the screen that changed this frame
+    DirtyRegions mDirtyRegions;
+    
+    // Keeps the last frame so only dirty regions have to be drawn, copied to the window before every present
+    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> mBackBuffer;
+    
     std::shared_ptr<SDL_Renderer> mRenderer;
     
+    // Spreads simulation and decoding work over every core, SDL rendering stays on the main thread
+    JobSystem mJobSystem;
+    
+    // Decodes images on worker threads so loading never stalls the main loop
+    AssetLoader mAssetLoader;
+    
+    // Streams music and plays sound effects, decoding on its own thread
+    AudioEngine mAudioEngine;
+    
+    // Writes autosaves off the main thread
+    SnapshotWriter mSnapshotWriter;
+    
+    // Every entity in the game and their components
+    EntityRegistry mRegistry;
+    
+    // Overlapping colliders, its contacts describe the positions at the end of the last update
+    CollisionWorld mCollisionWorld;
+    
+    // Smoke, sparks and other effects, stepped with the simulation and drawn over the sprites
+    ParticleSystem mParticleSystem;
+    
+    // Finds the sprites inside the camera without visiting the rest of the world
+    SpatialHash mSpatialIndex;
+    
+    // The part of the world shown in the window
+    SDL_Rect mCamera;
+    
+    // Static background tiles, drawn one chunk texture at a time
+    TileMap mTileMap;
+    
+    // Records the frame's draw commands so they can be sorted by layer and state before drawing
+    RenderQueue mRenderQueue;
+    
+    // Collects the frame's sprites so each atlas page is drawn in one submission
+    SpriteBatch mSpriteBatch;
+    
     std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)> mWindow;
 };
 
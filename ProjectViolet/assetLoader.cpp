@@ -0,0 +1,241 @@
+//
+//  assetLoader.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "assetLoader.hpp"
+#include "debug.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Same fields as the asset manager's cache key, flattened for the in-flight map
+    std::string makeRequestKey(const std::string &filePath, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+    {
+        char suffix[32];
+        
+        snprintf(suffix, sizeof(suffix), "|%d|%02X%02X%02X|%08X", colorKeyImage ? 1 : 0, colorKey.r, colorKey.g, colorKey.b, pixelFormat);
+        
+        return filePath + suffix;
+    }
+}
+
+TextureRequest::TextureRequest(std::string filePath, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat) : mFilePath(filePath), mColorKeyImage(colorKeyImage), mColorKey(colorKey), mPixelFormat(pixelFormat), mState(Queued), mDecodedSurface(nullptr, &SDL_FreeSurface), mTexture(nullptr)
+{
+    
+}
+
+bool TextureRequest::isReady()
+{
+    return mState.load(std::memory_order_acquire) == Ready;
+}
+
+bool TextureRequest::isFinished()
+{
+    RequestState state = mState.load(std::memory_order_acquire);
+    
+    return state == Ready || state == Failed;
+}
+
+std::shared_ptr<TextureAsset> TextureRequest::getTexture()
+{
+    return isReady() ? mTexture : nullptr;
+}
+
+AssetLoader::AssetLoader() : mRenderer(nullptr), mDecodeScheduler(nullptr), mRequestPool(std::make_shared<ObjectPool<TextureRequest>>(REQUEST_POOL_SIZE)), mRunning(false)
+{
+    
+}
+
+AssetLoader::~AssetLoader()
+{
+    stop();
+}
+
+void AssetLoader::start(std::shared_ptr<SDL_Renderer> &renderer, int workerCount)
+{
+    mRenderer = renderer;
+    
+    if (mRunning)
+        return;
+    
+    // Leave a core for the main thread
+    if (workerCount <= 0)
+        workerCount = std::max(1, SDL_GetCPUCount() - 1);
+    
+    mRunning = true;
+    
+    // An external scheduler does the decoding instead
+    if (mDecodeScheduler)
+        return;
+    
+    for (int i = 0; i < workerCount; i++)
+        mWorkers.emplace_back(&AssetLoader::workerLoop, this);
+}
+
+void AssetLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mDecodeMutex);
+        
+        mRunning = false;
+        mDecodeQueue.clear();
+    }
+    
+    mDecodeCondition.notify_all();
+    
+    for (std::thread &worker : mWorkers)
+        worker.join();
+    
+    mWorkers.clear();
+    
+    std::lock_guard<std::mutex> lock(mUploadMutex);
+    
+    mUploadQueue.clear();
+    mInFlight.clear();
+}
+
+size_t AssetLoader::getPeakRequestCount()
+{
+    return mRequestPool->getPeakCount();
+}
+
+void AssetLoader::setDecodeScheduler(std::function<void(std::function<void()>)> scheduler)
+{
+    mDecodeScheduler = scheduler;
+}
+
+std::shared_ptr<TextureRequest> AssetLoader::loadTextureAsync(std::string filePath, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+{
+    // Requests come from the pool, only falling back to the heap once it is exhausted
+    std::shared_ptr<TextureRequest> request = mRequestPool->makeShared(filePath, colorKeyImage, colorKey, pixelFormat);
+    
+    if (!request)
+        request = std::make_shared<TextureRequest>(filePath, colorKeyImage, colorKey, pixelFormat);
+    
+    // Already loaded, nothing to do
+    if (std::shared_ptr<TextureAsset> cachedTexture = AssetManager::findTexture(filePath, mRenderer.get(), colorKeyImage, colorKey, pixelFormat))
+    {
+        request->mTexture = cachedTexture;
+        request->mState.store(TextureRequest::Ready, std::memory_order_release);
+        
+        return request;
+    }
+    
+    // Already loading, share the request in flight
+    std::string key = makeRequestKey(filePath, colorKeyImage, colorKey, pixelFormat);
+    
+    auto inFlightRequest = mInFlight.find(key);
+    
+    if (inFlightRequest != mInFlight.end())
+        return inFlightRequest->second;
+    
+    mInFlight[key] = request;
+    
+    if (mDecodeScheduler)
+    {
+        mDecodeScheduler([this, request]()
+        {
+            decodeRequest(request);
+        });
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(mDecodeMutex);
+            
+            mDecodeQueue.push_back(request);
+        }
+        
+        mDecodeCondition.notify_one();
+    }
+    
+    return request;
+}
+
+void AssetLoader::workerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<TextureRequest> request;
+        
+        {
+            std::unique_lock<std::mutex> lock(mDecodeMutex);
+            
+            mDecodeCondition.wait(lock, [this]()
+            {
+                return !mRunning || !mDecodeQueue.empty();
+            });
+            
+            if (!mRunning)
+                return;
+            
+            request = mDecodeQueue.front();
+            mDecodeQueue.pop_front();
+        }
+        
+        decodeRequest(request);
+    }
+}
+
+void AssetLoader::decodeRequest(std::shared_ptr<TextureRequest> request)
+{
+    // File I/O, decoding, conversion and color keying all happen off the main thread
+    request->mDecodedSurface.reset(AssetManager::decodeImage(request->mFilePath, request->mColorKeyImage, request->mColorKey, request->mPixelFormat));
+    request->mState.store(TextureRequest::Decoded, std::memory_order_release);
+    
+    std::lock_guard<std::mutex> lock(mUploadMutex);
+    
+    mUploadQueue.push_back(request);
+}
+
+int AssetLoader::processUploads(double budgetSeconds)
+{
+    PROFILE_ZONE("AssetLoader::processUploads")
+    
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 deadline = SDL_GetPerformanceCounter() + static_cast<Uint64>(budgetSeconds * frequency);
+    
+    int uploadCount = 0;
+    
+    // Always upload at least one texture so loading can't stall behind a tiny budget
+    do
+    {
+        std::shared_ptr<TextureRequest> request;
+        
+        {
+            std::lock_guard<std::mutex> lock(mUploadMutex);
+            
+            if (mUploadQueue.empty())
+                break;
+            
+            request = mUploadQueue.front();
+            mUploadQueue.pop_front();
+        }
+        
+        if (request->mDecodedSurface)
+            request->mTexture = AssetManager::uploadTexture(request->mDecodedSurface.get(), request->mFilePath, mRenderer, request->mColorKeyImage, request->mColorKey, request->mPixelFormat);
+        
+        request->mDecodedSurface = nullptr;
+        request->mState.store(request->mTexture ? TextureRequest::Ready : TextureRequest::Failed, std::memory_order_release);
+        
+        mInFlight.erase(makeRequestKey(request->mFilePath, request->mColorKeyImage, request->mColorKey, request->mPixelFormat));
+        
+        uploadCount++;
+    }
+    while (SDL_GetPerformanceCounter() < deadline);
+    
+    PROFILE_COUNTER("Pending texture loads", mInFlight.size())
+    
+    return uploadCount;
+}
+
+int AssetLoader::getPendingCount()
+{
+    return static_cast<int>(mInFlight.size());
+}
@@ -0,0 +1,133 @@
+//
+//  assetLoader.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef assetLoader_hpp
+#define assetLoader_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "assetManager.hpp"
+#include "objectPool.hpp"
+
+// Tracks one asynchronous texture load, shared between the loader and everything waiting on it
+class TextureRequest
+{
+public:
+    enum RequestState
+    {
+        Queued,
+        Decoded,
+        Ready,
+        Failed
+    };
+    
+    TextureRequest(std::string filePath, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat);
+    
+    // Returns whether the texture has been uploaded and can be drawn
+    bool isReady();
+    
+    // Returns whether the load is over, successfully or not
+    bool isFinished();
+    
+    // Returns the texture once ready, nullptr before that or if the load failed
+    std::shared_ptr<TextureAsset> getTexture();
+
+private:
+    friend class AssetLoader;
+    
+    std::string mFilePath;
+    bool mColorKeyImage;
+    SDL_Color mColorKey;
+    Uint32 mPixelFormat;
+    
+    std::atomic<RequestState> mState;
+    
+    // Written by the decoding worker, consumed by the main thread's upload
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> mDecodedSurface;
+    
+    // Only touched on the main thread
+    std::shared_ptr<TextureAsset> mTexture;
+};
+
+// Decodes images on worker threads and uploads them on the main thread under a per-frame time budget
+class AssetLoader
+{
+public:
+    // Initializes the loader without starting any threads
+    AssetLoader();
+    
+    // Stops the workers, dropping anything not yet decoded
+    ~AssetLoader();
+    
+    // Starts the worker threads, 0 uses one less than the number of cores
+    void start(std::shared_ptr<SDL_Renderer> &renderer, int workerCount = 0);
+    
+    // Stops and joins the worker threads
+    void stop();
+    
+    // Queues an image for decoding, requests for an image already loaded or loading share its result
+    std::shared_ptr<TextureRequest> loadTextureAsync(std::string filePath, bool colorKeyImage = false, SDL_Color colorKey = {0xFF, 0x00, 0xDC}, Uint32 pixelFormat = SDL_PIXELFORMAT_UNKNOWN);
+    
+    // Uploads decoded images until the time budget is spent, must be called on the main thread, returns the number uploaded
+    int processUploads(double budgetSeconds);
+    
+    // Returns the number of requests that are not yet finished
+    int getPendingCount();
+    
+    // Returns the most requests that were alive at once, to size REQUEST_POOL_SIZE
+    size_t getPeakRequestCount();
+    
+    // Requests that can be alive at once before they start coming from the heap
+    static const size_t REQUEST_POOL_SIZE = 256;
+    
+    // Replaces the workers with an external scheduler such as the job system, must be set before start()
+    void setDecodeScheduler(std::function<void(std::function<void()>)> scheduler);
+
+private:
+    // Worker thread body, decodes queued requests until stopped
+    void workerLoop();
+    
+    // Decodes one request and hands it to the upload queue
+    void decodeRequest(std::shared_ptr<TextureRequest> request);
+    
+    std::shared_ptr<SDL_Renderer> mRenderer;
+    
+    std::vector<std::thread> mWorkers;
+    
+    // Requests waiting for a worker
+    std::mutex mDecodeMutex;
+    std::condition_variable mDecodeCondition;
+    std::deque<std::shared_ptr<TextureRequest>> mDecodeQueue;
+    
+    // Requests waiting for the main thread
+    std::mutex mUploadMutex;
+    std::deque<std::shared_ptr<TextureRequest>> mUploadQueue;
+    
+    // Requests not yet finished, keyed like the asset manager's cache so duplicate loads are merged
+    std::unordered_map<std::string, std::shared_ptr<TextureRequest>> mInFlight;
+    
+    std::function<void(std::function<void()>)> mDecodeScheduler;
+    
+    // Requests are short lived and made in bursts, so they are pooled
+    std::shared_ptr<ObjectPool<TextureRequest>> mRequestPool;
+    
+    bool mRunning;
+};
+
+#endif /* assetLoader_hpp */
@@ -0,0 +1,279 @@
+//
+//  assetManager.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "assetManager.hpp"
+#include "debug.hpp"
+#include "packArchive.hpp"
+#include "pixelConversion.hpp"
+#include "profiler.hpp"
+#include "textureResidency.hpp"
+
+#include <functional>
+#include <SDL_image.h>
+#include <unordered_map>
+
+namespace
+{
+    // Everything that makes two loads of the same file produce different textures
+    struct TextureKey
+    {
+        std::string filePath;
+        SDL_Renderer *renderer;
+        bool colorKeyed;
+        Uint32 colorKey;
+        Uint32 pixelFormat;
+        
+        bool operator==(const TextureKey &other) const
+        {
+            return filePath == other.filePath && renderer == other.renderer && colorKeyed == other.colorKeyed && colorKey == other.colorKey && pixelFormat == other.pixelFormat;
+        }
+    };
+    
+    struct TextureKeyHash
+    {
+        size_t operator()(const TextureKey &key) const
+        {
+            // Combine the member hashes the same way boost::hash_combine does
+            size_t seed = std::hash<std::string>()(key.filePath);
+            seed ^= std::hash<SDL_Renderer*>()(key.renderer) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<Uint32>()(key.colorKeyed ? key.colorKey : 0xFFFFFFFF) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<Uint32>()(key.pixelFormat) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            
+            return seed;
+        }
+    };
+    
+    // The cache only observes the textures, so a texture dies with its last holder
+    std::unordered_map<TextureKey, std::weak_ptr<TextureAsset>, TextureKeyHash> mTextureCache;
+    
+    TextureKey makeKey(const std::string &filePath, SDL_Renderer *renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+    {
+        return {filePath, renderer, colorKeyImage, static_cast<Uint32>((colorKey.r << 16) | (colorKey.g << 8) | colorKey.b), pixelFormat};
+    }
+}
+
+TextureAsset::TextureAsset(SDL_Texture *texture, int width, int height) : mTexture(texture, &SDL_DestroyTexture), mWidth(width), mHeight(height), mByteSize(TextureResidency::calculateByteSize(texture)), mLastUsedFrame(TextureResidency::getFrame())
+{
+    if (mTexture)
+        TextureResidency::track(this);
+}
+
+TextureAsset::~TextureAsset()
+{
+    if (mTexture)
+        TextureResidency::untrack(this);
+    
+    mTexture = nullptr;
+}
+
+SDL_Texture* TextureAsset::getTexture()
+{
+    mLastUsedFrame = TextureResidency::getFrame();
+    
+    // Evicted textures come back the first time anything asks for them
+    if (!mTexture && mSource)
+        reload();
+    
+    return mTexture.get();
+}
+
+void TextureAsset::setSource(const std::string &filePath, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+{
+    mSource.reset(new TextureSource {filePath, renderer, colorKeyImage, colorKey, pixelFormat});
+}
+
+void TextureAsset::evict()
+{
+    if (!mTexture || !mSource)
+        return;
+    
+    TextureResidency::untrack(this);
+    
+    mTexture = nullptr;
+}
+
+bool TextureAsset::isEvictable()
+{
+    return mSource != nullptr;
+}
+
+bool TextureAsset::isResident()
+{
+    return mTexture != nullptr;
+}
+
+size_t TextureAsset::getByteSize()
+{
+    return mByteSize;
+}
+
+Uint64 TextureAsset::getLastUsedFrame()
+{
+    return mLastUsedFrame;
+}
+
+bool TextureAsset::reload()
+{
+    PROFILE_ZONE("TextureAsset::reload")
+    
+    std::shared_ptr<SDL_Renderer> renderer = mSource->renderer.lock();
+    
+    if (!renderer)
+        return false;
+    
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loadedSurface(AssetManager::decodeImage(mSource->filePath, mSource->colorKeyImage, mSource->colorKey, mSource->pixelFormat), &SDL_FreeSurface);
+    
+    if (loadedSurface)
+        mTexture.reset(PixelConversion::createTexture(renderer.get(), loadedSurface.get(), mSource->pixelFormat));
+    
+    // A source that failed once is dropped, otherwise every draw of the texture would try to load it again
+    if (!mTexture)
+    {
+        LOG_MESSAGE(SevereError, "Failed to reload evicted texture %s!", mSource->filePath.c_str())
+        LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+        
+        mSource = nullptr;
+        
+        return false;
+    }
+    
+    mByteSize = TextureResidency::calculateByteSize(mTexture.get());
+    
+    TextureResidency::track(this);
+    TextureResidency::recordReload();
+    
+    return true;
+}
+
+namespace AssetManager
+{
+    std::shared_ptr<TextureAsset> findTexture(const std::string &filePath, SDL_Renderer *renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+    {
+        // Hand out the existing texture if anything is still holding on to it
+        auto cachedTexture = mTextureCache.find(makeKey(filePath, renderer, colorKeyImage, colorKey, pixelFormat));
+        
+        if (cachedTexture == mTextureCache.end())
+            return nullptr;
+        
+        return cachedTexture->second.lock();
+    }
+    
+    std::string findImageType(const std::string &filePath)
+    {
+        size_t extension = filePath.find_last_of('.');
+        
+        if (extension == std::string::npos || filePath.find_first_of("/\\", extension) != std::string::npos)
+            return "";
+        
+        return filePath.substr(extension + 1);
+    }
+    
+    SDL_Surface* decodeImage(const std::string &filePath, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+    {
+        PROFILE_ZONE("AssetManager::decodeImage")
+        
+        // Loads the image as a SDL surface, from a mounted pack archive when one has it
+        PackEntry packedImage;
+        
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loadedSurface(IMG_LoadTyped_RW(AssetPack::openFile(filePath, packedImage), 1, findImageType(filePath).c_str()), &SDL_FreeSurface);
+        
+        // Check if it loads successfully
+        if (!loadedSurface)
+        {
+            LOG_MESSAGE(SevereError, "Failed to load image from %s!", filePath.c_str())
+            LOG_MESSAGE(SDLImageError, "%s", IMG_GetError())
+            
+            return nullptr;
+        }
+        
+        // Convert the surface to the requested format before the color key is mapped into it, unless the upload's
+        // pixel conversion can produce the format itself in the same pass that applies the color key
+        bool convertedOnUpload = PixelConversion::canConvert(loadedSurface.get()) && PixelConversion::isSupportedDestination(pixelFormat);
+        
+        if (pixelFormat != SDL_PIXELFORMAT_UNKNOWN && loadedSurface->format->format != pixelFormat && !convertedOnUpload)
+        {
+            loadedSurface.reset(SDL_ConvertSurfaceFormat(loadedSurface.get(), pixelFormat, 0));
+            
+            if (!loadedSurface)
+            {
+                LOG_MESSAGE(SevereError, "Failed to convert %s to the requested pixel format!", filePath.c_str())
+                LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+                
+                return nullptr;
+            }
+        }
+        
+        // Color keys the image if enabled
+        if (colorKeyImage)
+            SDL_SetColorKey(loadedSurface.get(), SDL_TRUE, SDL_MapRGB(loadedSurface->format, colorKey.r, colorKey.g, colorKey.b));
+        
+        return loadedSurface.release();
+    }
+    
+    std::shared_ptr<TextureAsset> uploadTexture(SDL_Surface *surface, const std::string &filePath, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+    {
+        PROFILE_ZONE("AssetManager::uploadTexture")
+        
+        // Converts to the renderer's format and applies the color key in one pass instead of letting SDL do both
+        SDL_Texture *texture = PixelConversion::createTexture(renderer.get(), surface, pixelFormat);
+        
+        // Check if its loaded successfully
+        if (texture == nullptr)
+        {
+            LOG_MESSAGE(SevereError, "Failed to convert %s into a texture!", filePath.c_str())
+            LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+            
+            return nullptr;
+        }
+        
+        std::shared_ptr<TextureAsset> sharedTexture = std::make_shared<TextureAsset>(texture, surface->w, surface->h);
+        
+        // Textures loaded from a file can be dropped under memory pressure and loaded again on their next use
+        sharedTexture->setSource(filePath, renderer, colorKeyImage, colorKey, pixelFormat);
+        
+        mTextureCache[makeKey(filePath, renderer.get(), colorKeyImage, colorKey, pixelFormat)] = sharedTexture;
+        
+        return sharedTexture;
+    }
+    
+    std::shared_ptr<TextureAsset> loadTexture(const std::string &filePath, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+    {
+        if (std::shared_ptr<TextureAsset> sharedTexture = findTexture(filePath, renderer.get(), colorKeyImage, colorKey, pixelFormat))
+            return sharedTexture;
+        
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loadedSurface(decodeImage(filePath, colorKeyImage, colorKey, pixelFormat), &SDL_FreeSurface);
+        
+        if (!loadedSurface)
+            return nullptr;
+        
+        return uploadTexture(loadedSurface.get(), filePath, renderer, colorKeyImage, colorKey, pixelFormat);
+    }
+    
+    void releaseUnusedTextures()
+    {
+        for (auto entry = mTextureCache.begin(); entry != mTextureCache.end();)
+        {
+            if (entry->second.expired())
+                entry = mTextureCache.erase(entry);
+            else
+                ++entry;
+        }
+    }
+    
+    void clearTextureCache()
+    {
+        mTextureCache.clear();
+    }
+    
+    int getCachedTextureCount()
+    {
+        releaseUnusedTextures();
+        
+        return static_cast<int>(mTextureCache.size());
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  assetManager.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef assetManager_hpp
+#define assetManager_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+
+// A single SDL texture that can be shared between any number of texture wrappers
+class TextureAsset
+{
+public:
+    // Takes ownership of the passed texture
+    TextureAsset(SDL_Texture *texture, int width, int height);
+    
+    // Destroys the owned texture
+    ~TextureAsset();
+    
+    // Returns the shared SDL texture, reloading it first if it was evicted, and marks it as used this frame
+    SDL_Texture* getTexture();
+    
+    // Remembers where the texture came from, which lets it be evicted and reloaded later
+    void setSource(const std::string &filePath, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat);
+    
+    // Destroys the SDL texture until it is next used, does nothing if the texture can't be reloaded
+    void evict();
+    
+    // Returns true if the texture can be evicted, textures without a source file (text, render targets) can't be
+    bool isEvictable();
+    
+    // Returns true if the SDL texture currently exists
+    bool isResident();
+    
+    // Returns the video memory the texture takes up while resident
+    size_t getByteSize();
+    
+    // Returns the frame the texture was last used on
+    Uint64 getLastUsedFrame();
+    
+    // Returns the texture's original width
+    int getWidth();
+    
+    // Returns the texture's original height
+    int getHeight();
+
+private:
+    // Everything needed to decode and upload the texture again after it was evicted
+    struct TextureSource
+    {
+        std::string filePath;
+        std::weak_ptr<SDL_Renderer> renderer;
+        bool colorKeyImage;
+        SDL_Color colorKey;
+        Uint32 pixelFormat;
+    };
+    
+    // Decodes and uploads the texture from its source again, main thread only
+    bool reload();
+    
+    // The SDL texture shared by every holder of the asset
+    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> mTexture;
+    
+    // Only set for textures loaded from a file
+    std::unique_ptr<TextureSource> mSource;
+    
+    // Texture's dimensions, stored so holders don't have to query SDL for them
+    int mWidth, mHeight;
+    
+    // Video memory taken up by the texture, kept after eviction so reloading doesn't have to recalculate it
+    size_t mByteSize;
+    
+    // Frame the texture was last used on, for least recently used eviction
+    Uint64 mLastUsedFrame;
+};
+
+namespace AssetManager
+{
+    // Returns a shared texture for the image, only decoding and uploading it if no live copy exists
+    std::shared_ptr<TextureAsset> loadTexture(const std::string &filePath, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat);
+    
+    // Returns the cached texture for the image if a live copy exists, otherwise nullptr
+    std::shared_ptr<TextureAsset> findTexture(const std::string &filePath, SDL_Renderer *renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat);
+    
+    // Returns the image's extension, which SDL_image needs for formats it can't detect from their contents (TGA)
+    std::string findImageType(const std::string &filePath);
+    
+    // Loads, converts and color keys an image into a surface the caller owns, safe to call from any thread
+    SDL_Surface* decodeImage(const std::string &filePath, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat);
+    
+    // Uploads a decoded image and caches the texture under the image's key, main thread only
+    std::shared_ptr<TextureAsset> uploadTexture(SDL_Surface *surface, const std::string &filePath, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat);
+    
+    // Removes cache entries whose textures are no longer referenced by anything
+    void releaseUnusedTextures();
+    
+    // Forgets every cached texture, must be called before the renderer is destroyed
+    void clearTextureCache();
+    
+    // Returns the number of textures currently alive in the cache
+    int getCachedTextureCount();
+}
+
+#endif /* assetManager_hpp */
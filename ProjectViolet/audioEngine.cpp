@@ -0,0 +1,550 @@
+//
+//  audioEngine.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "audioEngine.hpp"
+#include "debug.hpp"
+#include "packArchive.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // Opus always decodes to 48kHz, and never more than 120ms per packet
+    const int OPUS_FREQUENCY = 48000;
+    const int OPUS_MAX_BLOCK_FRAMES = 5760;
+    
+    // How long the decoder sleeps before checking the ring for space again
+    const std::chrono::milliseconds DECODER_POLL_INTERVAL(5);
+    
+    static_assert((AudioEngine::MUSIC_BUFFER_BYTES & (AudioEngine::MUSIC_BUFFER_BYTES - 1)) == 0, "The music buffer size must be a power of two");
+}
+
+SoundEffect::SoundEffect(std::string filePath) : mFilePath(filePath), mState(Queued), mChunk(nullptr)
+{
+    
+}
+
+SoundEffect::~SoundEffect()
+{
+    // Chunks made from mSamples don't own them, so this only frees what SDL_mixer allocated
+    if (mChunk != nullptr)
+        Mix_FreeChunk(mChunk);
+}
+
+bool SoundEffect::isReady()
+{
+    return mState.load(std::memory_order_acquire) == Ready;
+}
+
+bool SoundEffect::isFinished()
+{
+    return mState.load(std::memory_order_acquire) != Queued;
+}
+
+AudioEngine::AudioEngine() : mFrequency(0), mChannels(0), mFormat(0), mMaxBlockBytes(0), mRingRead(0), mRingWrite(0), mFlushRequested(false), mMusicVolume(MIX_MAX_VOLUME), mUnderrunCount(0), mMusicFile(nullptr), mMixerMusic(nullptr), mMusicConverter(nullptr), mLoopMusic(false), mStopRequested(false), mRunning(false)
+{
+    
+}
+
+AudioEngine::~AudioEngine()
+{
+    stop();
+}
+
+bool AudioEngine::start(int voiceCount, int frequency, int chunkSize)
+{
+    PROFILE_ZONE("AudioEngine::start")
+    
+    if (mRunning)
+        return true;
+    
+    // OGG Vorbis tracks are left to SDL_mixer, so its decoder is wanted but not required
+    if (!(Mix_Init(MIX_INIT_OGG) & MIX_INIT_OGG))
+    {
+        LOG_MESSAGE(Warning, "SDL_mixer has no OGG support, only Opus music will play!")
+        LOG_MESSAGE(SDLMixerError, "%s", Mix_GetError())
+    }
+    
+    if (Mix_OpenAudio(frequency, MIX_DEFAULT_FORMAT, 2, chunkSize) < 0)
+    {
+        LOG_MESSAGE(SevereError, "Failed to open the audio device!")
+        LOG_MESSAGE(SDLMixerError, "%s", Mix_GetError())
+        
+        return false;
+    }
+    
+    // The device may not have given us what we asked for
+    Mix_QuerySpec(&mFrequency, &mFormat, &mChannels);
+    
+    int bytesPerFrame = SDL_AUDIO_BITSIZE(mFormat) / 8 * mChannels;
+    
+    mMaxBlockBytes = (static_cast<size_t>(OPUS_MAX_BLOCK_FRAMES) * mFrequency / OPUS_FREQUENCY + 64) * bytesPerFrame;
+    
+    // Everything the decoder and audio thread touch is allocated here, never while playing
+    mRing.assign(MUSIC_BUFFER_BYTES, 0);
+    mRingRead = 0;
+    mRingWrite = 0;
+    mFlushRequested = false;
+    
+    mDecodeBuffer.assign(OPUS_MAX_BLOCK_FRAMES * 2, 0);
+    mConvertBuffer.assign(mMaxBlockBytes, 0);
+    
+    // Opus decodes to 16 bit stereo at 48kHz, only convert when the device wants something else
+    if (mFrequency != OPUS_FREQUENCY || mFormat != AUDIO_S16SYS || mChannels != 2)
+        mMusicConverter = SDL_NewAudioStream(AUDIO_S16SYS, 2, OPUS_FREQUENCY, mFormat, static_cast<Uint8>(mChannels), mFrequency);
+    
+    mVoices.assign(Mix_AllocateChannels(voiceCount), {0, 0, nullptr});
+    
+    Mix_HookMusic(musicCallback, this);
+    
+    mStopRequested = false;
+    mRunning = true;
+    
+    mDecoderThread = std::thread(&AudioEngine::decoderLoop, this);
+    
+    return true;
+}
+
+void AudioEngine::stop()
+{
+    if (!mRunning)
+        return;
+    
+    {
+        std::lock_guard<std::mutex> lock(mCommandMutex);
+        
+        mStopRequested = true;
+        mCommands.clear();
+    }
+    
+    mCommandCondition.notify_all();
+    mDecoderThread.join();
+    
+    // Nothing may read the samples once they are freed
+    Mix_HookMusic(nullptr, nullptr);
+    Mix_HaltChannel(-1);
+    
+    mVoices.clear();
+    mSounds.clear();
+    
+    if (mMusicConverter != nullptr)
+    {
+        SDL_FreeAudioStream(mMusicConverter);
+        mMusicConverter = nullptr;
+    }
+    
+    Mix_CloseAudio();
+    Mix_Quit();
+    
+    mRunning = false;
+}
+
+std::shared_ptr<SoundEffect> AudioEngine::loadSound(std::string filePath)
+{
+    auto cached = mSounds.find(filePath);
+    
+    if (cached != mSounds.end())
+        return cached->second;
+    
+    std::shared_ptr<SoundEffect> sound = std::make_shared<SoundEffect>(filePath);
+    
+    mSounds[filePath] = sound;
+    
+    if (mRunning)
+        pushCommand({Command::LoadSound, filePath, false, sound});
+    else
+        sound->mState = SoundEffect::Failed;
+    
+    return sound;
+}
+
+int AudioEngine::playSound(std::shared_ptr<SoundEffect> &sound, int priority, int volume)
+{
+    PROFILE_ZONE("AudioEngine::playSound")
+    
+    if (!mRunning || !sound || !sound->isReady())
+        return -1;
+    
+    int channel = -1;
+    
+    // Take a free voice if there is one, otherwise remember the least important, oldest one
+    for (int voice = 0; voice < static_cast<int>(mVoices.size()); voice++)
+    {
+        if (!Mix_Playing(voice))
+        {
+            channel = voice;
+            
+            break;
+        }
+        
+        if (channel == -1 || mVoices[voice].priority < mVoices[channel].priority || (mVoices[voice].priority == mVoices[channel].priority && mVoices[voice].startTime < mVoices[channel].startTime))
+            channel = voice;
+    }
+    
+    if (channel == -1)
+        return -1;
+    
+    // Only steal from something no more important than the new sound
+    if (Mix_Playing(channel))
+    {
+        if (mVoices[channel].priority > priority)
+            return -1;
+        
+        Mix_HaltChannel(channel);
+    }
+    
+    Mix_Volume(channel, volume);
+    
+    if (Mix_PlayChannel(channel, sound->mChunk, 0) == -1)
+    {
+        LOG_MESSAGE(Error, "Failed to play %s!", sound->mFilePath.c_str())
+        LOG_MESSAGE(SDLMixerError, "%s", Mix_GetError())
+        
+        return -1;
+    }
+    
+    mVoices[channel] = {priority, SDL_GetTicks(), sound};
+    
+    return channel;
+}
+
+void AudioEngine::playMusic(std::string filePath, bool loop)
+{
+    if (mRunning)
+        pushCommand({Command::PlayMusic, filePath, loop, nullptr});
+}
+
+void AudioEngine::stopMusic()
+{
+    if (mRunning)
+        pushCommand({Command::StopMusic, "", false, nullptr});
+}
+
+void AudioEngine::setMusicVolume(int volume)
+{
+    volume = std::clamp(volume, 0, MIX_MAX_VOLUME);
+    
+    mMusicVolume = volume;
+    
+    // Tracks SDL_mixer plays itself use its own volume
+    Mix_VolumeMusic(volume);
+}
+
+void AudioEngine::clearSoundCache()
+{
+    mSounds.clear();
+}
+
+int AudioEngine::getMusicUnderrunCount()
+{
+    return mUnderrunCount;
+}
+
+void AudioEngine::pushCommand(Command command)
+{
+    {
+        std::lock_guard<std::mutex> lock(mCommandMutex);
+        
+        mCommands.push_back(std::move(command));
+    }
+    
+    mCommandCondition.notify_one();
+}
+
+void AudioEngine::musicCallback(void *userData, Uint8 *stream, int length)
+{
+    AudioEngine *engine = static_cast<AudioEngine*>(userData);
+    
+    size_t write = engine->mRingWrite.load(std::memory_order_acquire);
+    
+    // A new track is starting, throw away what is left of the old one
+    if (engine->mFlushRequested.load(std::memory_order_acquire))
+    {
+        engine->mRingRead.store(write, std::memory_order_release);
+        engine->mFlushRequested.store(false, std::memory_order_release);
+        
+        return;
+    }
+    
+    size_t read = engine->mRingRead.load(std::memory_order_relaxed);
+    size_t available = write - read;
+    
+    // Nothing playing leaves the ring empty, which isn't an underrun
+    if (available == 0)
+        return;
+    
+    size_t wanted = static_cast<size_t>(length);
+    
+    if (available < wanted)
+        engine->mUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+    
+    size_t count = std::min(available, wanted);
+    size_t offset = read & (MUSIC_BUFFER_BYTES - 1);
+    size_t firstPart = std::min(count, MUSIC_BUFFER_BYTES - offset);
+    int volume = engine->mMusicVolume.load(std::memory_order_relaxed);
+    
+    // The mixer silences the stream before calling, so the music is mixed in at its volume
+    SDL_MixAudioFormat(stream, engine->mRing.data() + offset, engine->mFormat, static_cast<Uint32>(firstPart), volume);
+    
+    if (count > firstPart)
+        SDL_MixAudioFormat(stream + firstPart, engine->mRing.data(), engine->mFormat, static_cast<Uint32>(count - firstPart), volume);
+    
+    engine->mRingRead.store(read + count, std::memory_order_release);
+}
+
+size_t AudioEngine::getRingFreeSpace()
+{
+    return MUSIC_BUFFER_BYTES - (mRingWrite.load(std::memory_order_relaxed) - mRingRead.load(std::memory_order_acquire));
+}
+
+void AudioEngine::writeRing(const Uint8 *data, size_t length)
+{
+    size_t write = mRingWrite.load(std::memory_order_relaxed);
+    size_t offset = write & (MUSIC_BUFFER_BYTES - 1);
+    size_t firstPart = std::min(length, MUSIC_BUFFER_BYTES - offset);
+    
+    std::copy(data, data + firstPart, mRing.begin() + offset);
+    std::copy(data + firstPart, data + length, mRing.begin());
+    
+    mRingWrite.store(write + length, std::memory_order_release);
+}
+
+void AudioEngine::decoderLoop()
+{
+    std::deque<Command> commands;
+    
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mCommandMutex);
+            
+            // Sleep until there are commands, or briefly while music needs the ring topped up
+            auto hasWork = [this]()
+            {
+                return mStopRequested || !mCommands.empty();
+            };
+            
+            if (mMusicFile != nullptr)
+                mCommandCondition.wait_for(lock, DECODER_POLL_INTERVAL, hasWork);
+            else
+                mCommandCondition.wait(lock, hasWork);
+            
+            if (mStopRequested)
+                break;
+            
+            commands.swap(mCommands);
+        }
+        
+        for (Command &command : commands)
+        {
+            switch (command.type)
+            {
+                case Command::PlayMusic:
+                    openMusic(command.filePath, command.loop);
+                    break;
+                
+                case Command::StopMusic:
+                    closeMusic();
+                    break;
+                
+                case Command::LoadSound:
+                    decodeSound(command.sound);
+                    break;
+            }
+        }
+        
+        commands.clear();
+        
+        // Fill the ring, but leave it alone until the audio thread has finished flushing the last track
+        while (mMusicFile != nullptr && !mFlushRequested.load(std::memory_order_acquire) && getRingFreeSpace() >= mMaxBlockBytes)
+        {
+            if (!decodeMusicBlock())
+                break;
+        }
+    }
+    
+    closeMusic();
+}
+
+void AudioEngine::openMusic(const std::string &filePath, bool loop)
+{
+    PROFILE_ZONE("AudioEngine::openMusic")
+    
+    closeMusic();
+    
+    int error = 0;
+    
+    // Packed tracks are streamed straight out of the archive's mapping
+    bool packed = AssetPack::findFile(filePath, mMusicData);
+    
+    mMusicFile = packed ? op_open_memory(mMusicData.data, mMusicData.size, &error) : op_open_file(filePath.c_str(), &error);
+    mLoopMusic = loop;
+    
+    if (mMusicFile != nullptr)
+    {
+        // Streamed Opus goes through the hook, take the music back from SDL_mixer
+        Mix_HookMusic(musicCallback, this);
+        
+        return;
+    }
+    
+    // Not Opus, let SDL_mixer stream it (OGG Vorbis and friends), which reads the file as it plays too
+    Mix_HookMusic(nullptr, nullptr);
+    
+    mMixerMusic = packed ? Mix_LoadMUS_RW(SDL_RWFromConstMem(mMusicData.data, static_cast<int>(mMusicData.size)), 1) : Mix_LoadMUS(filePath.c_str());
+    
+    if (mMixerMusic == nullptr || Mix_PlayMusic(mMixerMusic, loop ? -1 : 1) == -1)
+    {
+        LOG_MESSAGE(Error, "Failed to stream the music track %s! (opusfile error %d)", filePath.c_str(), error)
+        LOG_MESSAGE(SDLMixerError, "%s", Mix_GetError())
+        
+        closeMusic();
+    }
+}
+
+void AudioEngine::closeMusic()
+{
+    if (mMusicFile != nullptr)
+    {
+        op_free(mMusicFile);
+        mMusicFile = nullptr;
+        
+        // Decoded audio already in the ring belongs to the old track
+        mFlushRequested.store(true, std::memory_order_release);
+    }
+    
+    if (mMixerMusic != nullptr)
+    {
+        Mix_FreeMusic(mMixerMusic);
+        mMixerMusic = nullptr;
+    }
+    
+    // Nothing reads the track's bytes anymore
+    mMusicData = PackEntry();
+    
+    if (mMusicConverter != nullptr)
+        SDL_AudioStreamClear(mMusicConverter);
+}
+
+bool AudioEngine::decodeMusicBlock()
+{
+    int frames = op_read_stereo(mMusicFile, mDecodeBuffer.data(), static_cast<int>(mDecodeBuffer.size()));
+    
+    // A hole in the stream only loses a packet
+    if (frames == OP_HOLE)
+        return true;
+    
+    if (frames < 0)
+    {
+        LOG_MESSAGE(Error, "Failed to decode music, opusfile error %d!", frames)
+        
+        closeMusic();
+        
+        return false;
+    }
+    
+    if (frames == 0)
+    {
+        if (mLoopMusic && op_pcm_seek(mMusicFile, 0) == 0)
+            return true;
+        
+        // The track ends once the ring drains, without flushing it
+        op_free(mMusicFile);
+        mMusicFile = nullptr;
+        
+        return false;
+    }
+    
+    const Uint8 *decoded = reinterpret_cast<const Uint8*>(mDecodeBuffer.data());
+    int decodedBytes = frames * 2 * static_cast<int>(sizeof(opus_int16));
+    
+    if (mMusicConverter == nullptr)
+    {
+        writeRing(decoded, decodedBytes);
+        
+        return true;
+    }
+    
+    SDL_AudioStreamPut(mMusicConverter, decoded, decodedBytes);
+    
+    // Takes whatever whole frames the converter has ready, it may hold some back for filtering
+    int converted = SDL_AudioStreamGet(mMusicConverter, mConvertBuffer.data(), static_cast<int>(mConvertBuffer.size()));
+    
+    if (converted > 0)
+        writeRing(mConvertBuffer.data(), converted);
+    
+    return true;
+}
+
+void AudioEngine::decodeSound(std::shared_ptr<SoundEffect> sound)
+{
+    PROFILE_ZONE("AudioEngine::decodeSound")
+    
+    int error = 0;
+    
+    // The file's bytes, only needed until the effect is decoded
+    PackEntry packedSound;
+    
+    bool packed = AssetPack::findFile(sound->mFilePath, packedSound);
+    
+    OggOpusFile *file = packed ? op_open_memory(packedSound.data, packedSound.size, &error) : op_open_file(sound->mFilePath.c_str(), &error);
+    
+    if (file == nullptr)
+    {
+        // Everything SDL_mixer understands is decoded and converted by it
+        sound->mChunk = packed ? Mix_LoadWAV_RW(SDL_RWFromConstMem(packedSound.data, static_cast<int>(packedSound.size)), 1) : Mix_LoadWAV(sound->mFilePath.c_str());
+    }
+    else
+    {
+        // Effects are short, so the whole thing is decoded and converted to the device's format in one go
+        std::vector<opus_int16> samples;
+        int frames = 0;
+        
+        while ((frames = op_read_stereo(file, mDecodeBuffer.data(), static_cast<int>(mDecodeBuffer.size()))) != 0)
+        {
+            if (frames == OP_HOLE)
+                continue;
+            
+            if (frames < 0)
+                break;
+            
+            samples.insert(samples.end(), mDecodeBuffer.begin(), mDecodeBuffer.begin() + frames * 2);
+        }
+        
+        op_free(file);
+        
+        int sampleBytes = static_cast<int>(samples.size() * sizeof(opus_int16));
+        
+        SDL_AudioStream *converter = SDL_NewAudioStream(AUDIO_S16SYS, 2, OPUS_FREQUENCY, mFormat, static_cast<Uint8>(mChannels), mFrequency);
+        
+        if (frames >= 0 && converter != nullptr && SDL_AudioStreamPut(converter, samples.data(), sampleBytes) == 0 && SDL_AudioStreamFlush(converter) == 0)
+        {
+            sound->mSamples.resize(SDL_AudioStreamAvailable(converter));
+            SDL_AudioStreamGet(converter, sound->mSamples.data(), static_cast<int>(sound->mSamples.size()));
+            
+            sound->mChunk = Mix_QuickLoad_RAW(sound->mSamples.data(), static_cast<Uint32>(sound->mSamples.size()));
+        }
+        
+        if (converter != nullptr)
+            SDL_FreeAudioStream(converter);
+    }
+    
+    if (sound->mChunk == nullptr)
+    {
+        LOG_MESSAGE(Error, "Failed to decode the sound effect %s!", sound->mFilePath.c_str())
+        LOG_MESSAGE(SDLMixerError, "%s", Mix_GetError())
+        
+        sound->mState.store(SoundEffect::Failed, std::memory_order_release);
+    }
+    else
+    {
+        sound->mState.store(SoundEffect::Ready, std::memory_order_release);
+    }
+}
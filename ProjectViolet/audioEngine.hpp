@@ -0,0 +1,193 @@
+//
+//  audioEngine.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef audioEngine_hpp
+#define audioEngine_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <opus/opusfile.h>
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "packArchive.hpp"
+
+// A short effect decoded once into the device's format, shared by every voice playing it
+class SoundEffect
+{
+public:
+    enum LoadState
+    {
+        Queued,
+        Ready,
+        Failed
+    };
+    
+    SoundEffect(std::string filePath);
+    
+    // Frees the decoded samples
+    ~SoundEffect();
+    
+    // Returns whether the effect has been decoded and can be played
+    bool isReady();
+    
+    // Returns whether decoding is over, successfully or not
+    bool isFinished();
+
+private:
+    friend class AudioEngine;
+    
+    std::string mFilePath;
+    
+    std::atomic<LoadState> mState;
+    
+    // Written by the decoder thread before mState becomes Ready, read only after that
+    Mix_Chunk *mChunk;
+    
+    // Opus effects are decoded by hand, the chunk points into this instead of owning its samples
+    std::vector<Uint8> mSamples;
+};
+
+// Streams music through a fixed ring buffer and plays effects on a bounded voice pool,
+// all decoding happens on the engine's own thread
+class AudioEngine
+{
+public:
+    // Initializes the engine without opening the audio device
+    AudioEngine();
+    
+    // Stops the engine if it is still running
+    ~AudioEngine();
+    
+    // Opens the audio device, allocates the voices and starts the decoder thread
+    bool start(int voiceCount = 32, int frequency = 48000, int chunkSize = 1024);
+    
+    // Halts everything playing, joins the decoder thread and closes the device
+    void stop();
+    
+    // Queues an effect for decoding, loads of an effect already loaded or loading share its result
+    std::shared_ptr<SoundEffect> loadSound(std::string filePath);
+    
+    // Plays a decoded effect, taking the lowest priority voice if all are busy,
+    // returns the voice used or -1 if every voice is playing something more important
+    int playSound(std::shared_ptr<SoundEffect> &sound, int priority = 0, int volume = MIX_MAX_VOLUME);
+    
+    // Starts streaming a track, replacing the current one, Opus is decoded by the engine and anything else by SDL_mixer
+    void playMusic(std::string filePath, bool loop = true);
+    
+    // Stops the current track
+    void stopMusic();
+    
+    // Sets the music volume, from 0 to MIX_MAX_VOLUME
+    void setMusicVolume(int volume);
+    
+    // Drops the engine's references to every loaded effect
+    void clearSoundCache();
+    
+    // Returns how many times the device wanted music the decoder hadn't produced yet
+    int getMusicUnderrunCount();
+    
+    // Bytes of decoded music waiting in the ring buffer
+    static const size_t MUSIC_BUFFER_BYTES = 1 << 18;
+
+private:
+    struct Command
+    {
+        enum CommandType
+        {
+            PlayMusic,
+            StopMusic,
+            LoadSound
+        };
+        
+        CommandType type;
+        
+        std::string filePath;
+        bool loop;
+        
+        std::shared_ptr<SoundEffect> sound;
+    };
+    
+    struct Voice
+    {
+        int priority;
+        Uint32 startTime;
+        
+        // Keeps the samples alive while the voice might still be reading them
+        std::shared_ptr<SoundEffect> sound;
+    };
+    
+    // SDL_mixer's music hook, runs on the audio thread and only reads the ring buffer
+    static void musicCallback(void *userData, Uint8 *stream, int length);
+    
+    // Decoder thread body, runs commands and keeps the ring buffer full
+    void decoderLoop();
+    
+    // Sends a command to the decoder thread
+    void pushCommand(Command command);
+    
+    // Decoder thread helpers
+    void openMusic(const std::string &filePath, bool loop);
+    void closeMusic();
+    bool decodeMusicBlock();
+    void decodeSound(std::shared_ptr<SoundEffect> sound);
+    
+    size_t getRingFreeSpace();
+    void writeRing(const Uint8 *data, size_t length);
+    
+    // Device format, queried once the device is open
+    int mFrequency, mChannels;
+    Uint16 mFormat;
+    
+    // Largest number of converted bytes one decoded block can produce
+    size_t mMaxBlockBytes;
+    
+    // Single producer (decoder thread) single consumer (audio thread) ring, the indices only ever grow
+    std::vector<Uint8> mRing;
+    std::atomic<size_t> mRingRead, mRingWrite;
+    
+    // Set by the decoder when switching tracks, the audio thread empties the ring and clears it
+    std::atomic<bool> mFlushRequested;
+    
+    std::atomic<int> mMusicVolume;
+    std::atomic<int> mUnderrunCount;
+    
+    // Music state, only touched by the decoder thread
+    OggOpusFile *mMusicFile;
+    Mix_Music *mMixerMusic;
+    SDL_AudioStream *mMusicConverter;
+    bool mLoopMusic;
+    
+    // Bytes of a track read from a pack archive, must outlive mMusicFile and mMixerMusic
+    PackEntry mMusicData;
+    std::vector<opus_int16> mDecodeBuffer;
+    std::vector<Uint8> mConvertBuffer;
+    
+    std::thread mDecoderThread;
+    
+    std::mutex mCommandMutex;
+    std::condition_variable mCommandCondition;
+    std::deque<Command> mCommands;
+    bool mStopRequested;
+    
+    // Main thread only
+    std::unordered_map<std::string, std::shared_ptr<SoundEffect>> mSounds;
+    std::vector<Voice> mVoices;
+    
+    bool mRunning;
+};
+
+#endif /* audioEngine_hpp */
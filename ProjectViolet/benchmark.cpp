@@ -0,0 +1,427 @@
+//
+//  benchmark.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "benchmark.hpp"
+#include "bitmapFont.hpp"
+#include "collisionWorld.hpp"
+#include "debug.hpp"
+#include "frameArena.hpp"
+#include "particleSystem.hpp"
+#include "pixelConversion.hpp"
+#include "renderQueue.hpp"
+#include "spriteBatch.hpp"
+#include "textCache.hpp"
+#include "textureWrapper.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace
+{
+    // Timings are taken with the performance counter and reported in milliseconds
+    double secondsSince(Uint64 start)
+    {
+        return static_cast<double>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    }
+    
+    // Picks the sample at a percentile of sorted timings
+    double percentile(const std::vector<double> &sortedTimings, double fraction)
+    {
+        size_t index = static_cast<size_t>(fraction * (sortedTimings.size() - 1) + 0.5);
+        
+        return sortedTimings[std::min(index, sortedTimings.size() - 1)];
+    }
+    
+    // Writes a 32x32 test image, the repository ships no art so the benchmark makes its own
+    bool writeTestImage(std::string filePath)
+    {
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface(SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_ARGB8888), &SDL_FreeSurface);
+        
+        if (!surface)
+            return false;
+        
+        SDL_FillRect(surface.get(), nullptr, SDL_MapRGBA(surface->format, 0x80, 0x40, 0xC0, 0xFF));
+        
+        SDL_Rect keyedCorner {0, 0, 8, 8};
+        SDL_FillRect(surface.get(), &keyedCorner, SDL_MapRGBA(surface->format, 0xFF, 0x00, 0xDC, 0xFF));
+        
+        return SDL_SaveBMP(surface.get(), filePath.c_str()) == 0;
+    }
+}
+
+namespace Benchmark
+{
+    TimingStatistics computeStatistics(std::vector<double> &timings)
+    {
+        TimingStatistics statistics {static_cast<int>(timings.size()), 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        
+        if (timings.empty())
+            return statistics;
+        
+        std::sort(timings.begin(), timings.end());
+        
+        statistics.mean = std::accumulate(timings.begin(), timings.end(), 0.0) / timings.size() * 1000.0;
+        statistics.minimum = timings.front() * 1000.0;
+        statistics.p50 = percentile(timings, 0.50) * 1000.0;
+        statistics.p90 = percentile(timings, 0.90) * 1000.0;
+        statistics.p99 = percentile(timings, 0.99) * 1000.0;
+        statistics.maximum = timings.back() * 1000.0;
+        
+        return statistics;
+    }
+    
+    void writeResult(std::ostream &output, std::string name, int objectCount, TimingStatistics statistics)
+    {
+        output << "{\"benchmark\":\"" << name << "\",\"objects\":" << objectCount << ",\"samples\":" << statistics.samples
+               << ",\"mean_ms\":" << statistics.mean << ",\"min_ms\":" << statistics.minimum << ",\"p50_ms\":" << statistics.p50
+               << ",\"p90_ms\":" << statistics.p90 << ",\"p99_ms\":" << statistics.p99 << ",\"max_ms\":" << statistics.maximum << "}\n";
+    }
+    
+    TimingStatistics measure(int iterations, std::function<void()> iteration)
+    {
+        // Warm caches, drivers and lazily created state before timing
+        for (int i = 0; i < 3; i++)
+            iteration();
+        
+        std::vector<double> timings;
+        timings.reserve(iterations);
+        
+        for (int i = 0; i < iterations; i++)
+        {
+            // Each iteration is a frame as far as scratch memory is concerned
+            FrameMemory::beginFrame();
+            
+            Uint64 start = SDL_GetPerformanceCounter();
+            
+            iteration();
+            
+            timings.push_back(secondsSince(start));
+        }
+        
+        return computeStatistics(timings);
+    }
+    
+    bool runSuite(std::shared_ptr<SDL_Renderer> &renderer, std::string outputPath, int objectCount, int iterations)
+    {
+        std::ofstream outputFile;
+        
+        if (!outputPath.empty())
+        {
+            outputFile.open(outputPath, std::ofstream::out | std::ofstream::trunc);
+            
+            if (!outputFile)
+            {
+                LOG_MESSAGE(Error, "Failed to open %s for the benchmark results!", outputPath.c_str())
+                
+                return false;
+            }
+        }
+        
+        std::ostream &output = outputPath.empty() ? std::cout : outputFile;
+        
+        const std::string imagePath = "violet_benchmark_image.bmp";
+        
+        if (!writeTestImage(imagePath))
+        {
+            LOG_MESSAGE(Error, "Failed to write the benchmark test image!")
+            LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+            
+            return false;
+        }
+        
+        SDL_Rect camera {0, 0, 750, 750};
+        
+        // Texture creation: the first load decodes and uploads, the rest should hit the shared texture cache
+        {
+            std::vector<TextureWrapper> wrappers(objectCount);
+            
+            writeResult(output, "texture_init_from_file_cached", objectCount, measure(iterations, [&]()
+            {
+                for (TextureWrapper &wrapper : wrappers)
+                    wrapper.initFromFile(imagePath, 1.0, 1.0, renderer, true);
+            }));
+        }
+        
+        writeResult(output, "texture_init_from_file_uncached", 1, measure(iterations, [&]()
+        {
+            TextureWrapper wrapper;
+            
+            AssetManager::clearTextureCache();
+            wrapper.initFromFile(imagePath, 1.0, 1.0, renderer, true);
+        }));
+        
+        writeResult(output, "texture_init_from_rectangle", 1, measure(iterations, [&]()
+        {
+            TextureWrapper wrapper;
+            
+            wrapper.initFromRectangle({0, 0, 32, 32}, {0x20, 0x80, 0x20, 0xFF}, renderer);
+        }));
+        
+        // Image upload: SDL converting and color keying inside SDL_CreateTextureFromSurface against the one pass pixel conversion
+        {
+            const int imageSize = 1024;
+            
+            std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> image(SDL_CreateRGBSurfaceWithFormat(0, imageSize, imageSize, 24, SDL_PIXELFORMAT_RGB24), &SDL_FreeSurface);
+            
+            if (image)
+            {
+                // Opaque 24 bit images with a color key are what most of the game's art decodes to
+                Uint8 *pixels = static_cast<Uint8*>(image->pixels);
+                
+                for (int y = 0; y < imageSize; y++)
+                {
+                    for (int x = 0; x < imageSize * 3; x++)
+                        pixels[y * image->pitch + x] = static_cast<Uint8>(x * 7 + y * 13);
+                }
+                
+                SDL_SetColorKey(image.get(), SDL_TRUE, SDL_MapRGB(image->format, 0xFF, 0x00, 0xDC));
+                
+                writeResult(output, "image_upload_sdl", 1, measure(iterations, [&]()
+                {
+                    SDL_DestroyTexture(SDL_CreateTextureFromSurface(renderer.get(), image.get()));
+                }));
+                
+                writeResult(output, "image_upload_staged", 1, measure(iterations, [&]()
+                {
+                    SDL_DestroyTexture(PixelConversion::createTexture(renderer.get(), image.get(), SDL_PIXELFORMAT_UNKNOWN));
+                }));
+                
+                // The vector kernels only take 32 bit pixels, so each kernel is timed on a copy with alpha
+                std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> alphaImage(SDL_ConvertSurfaceFormat(image.get(), SDL_PIXELFORMAT_ABGR8888, 0), &SDL_FreeSurface);
+                std::vector<Uint32> converted(imageSize * imageSize);
+                
+                PixelConversion::Kernel bestKernel = PixelConversion::getBestKernel();
+                
+                for (int kernel = static_cast<int>(PixelConversion::Kernel::Scalar); alphaImage && kernel <= static_cast<int>(bestKernel); kernel++)
+                {
+                    PixelConversion::setKernel(static_cast<PixelConversion::Kernel>(kernel));
+                    
+                    writeResult(output, std::string("pixel_convert_premultiplied_") + PixelConversion::getKernelName(PixelConversion::getKernel()), 1, measure(iterations, [&]()
+                    {
+                        PixelConversion::convert(alphaImage.get(), SDL_PIXELFORMAT_ARGB8888, true, converted.data(), imageSize * 4);
+                    }));
+                }
+                
+                PixelConversion::setKernel(bestKernel);
+            }
+        }
+        
+        // Rendering: one SDL_RenderCopyEx per object against one batched submission per texture
+        {
+            std::vector<TextureWrapper> wrappers(objectCount);
+            
+            for (TextureWrapper &wrapper : wrappers)
+                wrapper.initFromFile(imagePath, 1.0, 1.0, renderer, true);
+            
+            writeResult(output, "render_immediate", objectCount, measure(iterations, [&]()
+            {
+                SDL_RenderClear(renderer.get());
+                
+                for (int i = 0; i < objectCount; i++)
+                    wrappers[i].render((i * 37) % 718, (i * 91) % 718, false, camera);
+                
+                SDL_RenderPresent(renderer.get());
+            }));
+            
+            RenderQueue renderQueue;
+            
+            writeResult(output, "render_queued", objectCount, measure(iterations, [&]()
+            {
+                SDL_RenderClear(renderer.get());
+                
+                for (int i = 0; i < objectCount; i++)
+                    wrappers[i].queue(renderQueue, (i * 37) % 718, (i * 91) % 718, i % 4, false, camera);
+                
+                renderQueue.flush(renderer);
+                SDL_RenderPresent(renderer.get());
+            }));
+            
+            SpriteBatch spriteBatch;
+            
+            writeResult(output, "render_batched", objectCount, measure(iterations, [&]()
+            {
+                SDL_RenderClear(renderer.get());
+                spriteBatch.begin(renderer);
+                
+                for (int i = 0; i < objectCount; i++)
+                    wrappers[i].renderBatched(spriteBatch, (i * 37) % 718, (i * 91) % 718, false, camera);
+                
+                spriteBatch.flush();
+                SDL_RenderPresent(renderer.get());
+            }));
+        }
+        
+        // Collision: the sort and sweep with each kernel, on bodies drifting back and forth a little every step
+        {
+            CollisionWorld collisionWorld;
+            
+            // The world grows with the body count, so each body keeps overlapping a handful of others
+            const float worldSize = std::sqrt(static_cast<float>(objectCount)) * 24.0f;
+            const float bodySize = 16.0f;
+            
+            std::vector<float> positions(objectCount * 2);
+            
+            for (int i = 0; i < objectCount; i++)
+            {
+                positions[i * 2] = static_cast<float>((i * 7919) % 10007) / 10007.0f * worldSize;
+                positions[i * 2 + 1] = static_cast<float>((i * 104729) % 10009) / 10009.0f * worldSize;
+            }
+            
+            Uint32 step = 0;
+            
+            // Scalar first, then the vector kernel if this CPU has one
+            std::vector<CollisionWorld::Kernel> kernels = {CollisionWorld::Kernel::Scalar};
+            
+            if (CollisionWorld::getBestKernel() != CollisionWorld::Kernel::Scalar)
+                kernels.push_back(CollisionWorld::getBestKernel());
+            
+            for (CollisionWorld::Kernel kernel : kernels)
+            {
+                collisionWorld.setKernel(kernel);
+                
+                writeResult(output, std::string("collision_sweep_") + CollisionWorld::getKernelName(collisionWorld.getKernel()), objectCount, measure(iterations, [&]()
+                {
+                    float drift = (++step & 32) ? 0.5f : -0.5f;
+                    
+                    for (int i = 0; i < objectCount; i++)
+                    {
+                        float &x = positions[i * 2];
+                        float y = positions[i * 2 + 1];
+                        
+                        x += (i & 1) ? drift : -drift;
+                        
+                        collisionWorld.update({static_cast<Uint32>(i), 0}, x, y, x + bodySize, y + bodySize);
+                    }
+                    
+                    collisionWorld.findContacts();
+                }));
+            }
+        }
+        
+        // Particles: a pool of twenty per object stepped with each kernel, with particles dying and respawning, then drawn
+        {
+            std::shared_ptr<TextureAsset> particleTexture = AssetManager::loadTexture(imagePath, renderer, false, {0x00, 0x00, 0x00, 0x00}, SDL_PIXELFORMAT_UNKNOWN);
+            
+            const int particleCount = objectCount * 20;
+            
+            EmitterSettings settings;
+            
+            settings.texture = particleTexture;
+            settings.capacity = particleCount;
+            settings.lifetime = 2.0f;
+            settings.lifetimeVariance = 1.0f;
+            settings.rate = particleCount / settings.lifetime;
+            settings.speed = 100.0f;
+            settings.speedVariance = 50.0f;
+            settings.accelerationY = 30.0f;
+            settings.drag = 0.5f;
+            settings.startSize = 4.0f;
+            settings.endSize = 12.0f;
+            settings.startColor = {0xFF, 0xC0, 0x40, 0xFF};
+            settings.endColor = {0x40, 0x40, 0x40, 0x00};
+            
+            ParticleSystem particleSystem;
+            
+            int emitter = particleSystem.createEmitter(settings, camera.w * 0.5f, camera.h * 0.5f);
+            
+            particleSystem.burst(emitter, particleCount);
+            
+            std::vector<ParticleSystem::Kernel> kernels = {ParticleSystem::Kernel::Scalar};
+            
+            if (ParticleSystem::getBestKernel() != ParticleSystem::Kernel::Scalar)
+                kernels.push_back(ParticleSystem::getBestKernel());
+            
+            for (ParticleSystem::Kernel kernel : kernels)
+            {
+                particleSystem.setKernel(kernel);
+                
+                writeResult(output, std::string("particles_update_") + ParticleSystem::getKernelName(particleSystem.getKernel()), particleCount, measure(iterations, [&]()
+                {
+                    particleSystem.update(1.0 / 60.0);
+                }));
+            }
+            
+            if (particleTexture)
+            {
+                writeResult(output, "particles_render", particleSystem.getLiveCount(), measure(iterations, [&]()
+                {
+                    SDL_RenderClear(renderer.get());
+                    
+                    particleSystem.render(renderer.get(), camera, 0.0f);
+                    
+                    SDL_RenderPresent(renderer.get());
+                }));
+            }
+        }
+        
+        // Text: the repository ships no font, so text benchmarks run only when one is supplied
+        if (const char *fontPath = SDL_getenv("VIOLET_BENCHMARK_FONT"))
+        {
+            std::shared_ptr<TTF_Font> font(TTF_OpenFont(fontPath, 16), &TTF_CloseFont);
+            std::shared_ptr<BitmapFont> bitmapFont = FontCache::loadFont(fontPath, 16, renderer);
+            
+            const int textCount = std::max(1, objectCount / 50);
+            char text[64];
+            
+            if (font)
+            {
+                std::vector<TextureWrapper> labels(textCount);
+                
+                writeResult(output, "text_init_from_string", textCount, measure(iterations, [&]()
+                {
+                    for (int i = 0; i < textCount; i++)
+                    {
+                        snprintf(text, sizeof(text), "Score: %d", i * 1337);
+                        labels[i].initFromString(text, font, {0x00, 0x00, 0x00, 0xFF}, renderer);
+                    }
+                }));
+                
+                // Every label rasterized again, what each rebuild cost before the text cache
+                writeResult(output, "text_init_from_string_uncached", textCount, measure(iterations, [&]()
+                {
+                    TextCache::clearTextCache();
+                    
+                    for (int i = 0; i < textCount; i++)
+                    {
+                        snprintf(text, sizeof(text), "Score: %d", i * 1337);
+                        labels[i].initFromString(text, font, {0x00, 0x00, 0x00, 0xFF}, renderer);
+                    }
+                }));
+            }
+            
+            if (bitmapFont)
+            {
+                SpriteBatch spriteBatch;
+                
+                writeResult(output, "text_bitmap_font", textCount, measure(iterations, [&]()
+                {
+                    spriteBatch.begin(renderer);
+                    
+                    for (int i = 0; i < textCount; i++)
+                    {
+                        snprintf(text, sizeof(text), "Score: %d", i * 1337);
+                        bitmapFont->drawText(spriteBatch, text, 0, (i * 17) % 700, {0x00, 0x00, 0x00, 0xFF});
+                    }
+                    
+                    spriteBatch.flush();
+                }));
+            }
+        }
+        else
+        {
+            LOG_MESSAGE(Information, "Set VIOLET_BENCHMARK_FONT to a .ttf file to include the text benchmarks")
+        }
+        
+        remove(imagePath.c_str());
+        
+        return true;
+    }
+}
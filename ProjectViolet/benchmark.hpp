@@ -0,0 +1,42 @@
+//
+//  benchmark.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef benchmark_hpp
+#define benchmark_hpp
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+    // Summary of a set of timings, all in milliseconds
+    struct TimingStatistics
+    {
+        int samples;
+        double mean, minimum, p50, p90, p99, maximum;
+    };
+    
+    // Summarizes timings given in seconds, reorders the passed vector
+    TimingStatistics computeStatistics(std::vector<double> &timings);
+    
+    // Writes one result as a single line of JSON so CI can diff runs
+    void writeResult(std::ostream &output, std::string name, int objectCount, TimingStatistics statistics);
+    
+    // Times a function over a number of iterations, after a few untimed warm up runs
+    TimingStatistics measure(int iterations, std::function<void()> iteration);
+    
+    // Runs the render, texture creation and text micro-benchmarks and writes their results to the file (or stdout if empty)
+    bool runSuite(std::shared_ptr<SDL_Renderer> &renderer, std::string outputPath, int objectCount = 5000, int iterations = 60);
+}
+
+#endif /* benchmark_hpp */
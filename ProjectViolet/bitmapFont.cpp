@@ -0,0 +1,325 @@
+//
+//  bitmapFont.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "bitmapFont.hpp"
+#include "debug.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Fonts are keyed by file, point size and renderer, and die with their last holder
+    std::unordered_map<std::string, std::weak_ptr<BitmapFont>> mFontCache;
+    
+    // Decodes UTF-8 into code points, anything outside the basic multilingual plane becomes '?'
+    void decodeUTF8(const std::string &text, std::vector<Uint16> &codePoints)
+    {
+        codePoints.clear();
+        
+        for (size_t i = 0; i < text.size();)
+        {
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            Uint32 codePoint = '?';
+            size_t length = 1;
+            
+            if (lead < 0x80)
+            {
+                codePoint = lead;
+            }
+            else if ((lead & 0xE0) == 0xC0 && i + 1 < text.size())
+            {
+                codePoint = ((lead & 0x1F) << 6) | (text[i + 1] & 0x3F);
+                length = 2;
+            }
+            else if ((lead & 0xF0) == 0xE0 && i + 2 < text.size())
+            {
+                codePoint = ((lead & 0x0F) << 12) | ((text[i + 1] & 0x3F) << 6) | (text[i + 2] & 0x3F);
+                length = 3;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                length = 4;
+            }
+            
+            codePoints.push_back(static_cast<Uint16>(codePoint));
+            i += length;
+        }
+    }
+}
+
+BitmapFont::BitmapFont() : mRenderer(nullptr), mFont(nullptr, &TTF_CloseFont), mAtlasTexture(nullptr), mLineSkip(0), mFontHeight(0), mUseKerning(false)
+{
+    mAsciiGlyphs.fill({{0, 0, 0, 0}, 0, false});
+}
+
+BitmapFont::~BitmapFont()
+{
+    mFont = nullptr;
+    mAtlasTexture = nullptr;
+    mRenderer = nullptr;
+}
+
+bool BitmapFont::init(std::string fontPath, int pointSize, std::shared_ptr<SDL_Renderer> &renderer, int atlasSize)
+{
+    mRenderer = renderer;
+    
+    // The old font may still be reading the old file's bytes
+    mFont = nullptr;
+    
+    // Open the font at the requested size, from a mounted pack archive when one has it
+    mFont.reset(TTF_OpenFontRW(AssetPack::openFile(fontPath, mFontData), 1, pointSize));
+    
+    if (!mFont)
+    {
+        LOG_MESSAGE(SevereError, "Failed to open font %s!", fontPath.c_str())
+        LOG_MESSAGE(SDLFontError, "%s", TTF_GetError())
+        
+        return false;
+    }
+    
+    mLineSkip = TTF_FontLineSkip(mFont.get());
+    mFontHeight = TTF_FontHeight(mFont.get());
+    mUseKerning = TTF_GetFontKerning(mFont.get()) != 0;
+    
+    // Glyphs are uploaded one at a time as they are first used
+    SDL_Texture *texture = SDL_CreateTexture(mRenderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, atlasSize, atlasSize);
+    
+    if (texture == nullptr)
+    {
+        LOG_MESSAGE(SevereError, "Failed to create the glyph atlas for %s!", fontPath.c_str())
+        LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+        
+        return false;
+    }
+    
+    mAtlasTexture = std::make_shared<TextureAsset>(texture, atlasSize, atlasSize);
+    
+    // Start the atlas out fully transparent
+    std::vector<Uint32> clearPixels(static_cast<size_t>(atlasSize) * atlasSize, 0);
+    
+    SDL_UpdateTexture(texture, nullptr, clearPixels.data(), atlasSize * sizeof(Uint32));
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    
+    mPacker.reset(atlasSize, atlasSize);
+    
+    // Rasterize the printable ASCII range up front, since nearly all text uses it
+    for (Uint16 codePoint = ' '; codePoint < 0x7F; codePoint++)
+        findGlyph(codePoint);
+    
+    return true;
+}
+
+BitmapFont::Glyph& BitmapFont::findGlyph(Uint16 codePoint)
+{
+    Glyph &glyph = codePoint < mAsciiGlyphs.size() ? mAsciiGlyphs[codePoint] : mExtendedGlyphs[codePoint];
+    
+    if (glyph.loaded)
+        return glyph;
+    
+    // Whatever happens, the glyph is only attempted once
+    glyph = {{0, 0, 0, 0}, 0, true};
+    
+    int minX, maxX, minY, maxY;
+    
+    if (!TTF_GlyphIsProvided(mFont.get(), codePoint) || TTF_GlyphMetrics(mFont.get(), codePoint, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0)
+        return glyph;
+    
+    // Whitespace only moves the pen
+    if (codePoint == ' ' || codePoint == '\t')
+        return glyph;
+    
+    // Rasterize in white so the text color can be applied per quad
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> glyphSurface(TTF_RenderGlyph_Blended(mFont.get(), codePoint, {0xFF, 0xFF, 0xFF, 0xFF}), &SDL_FreeSurface);
+    
+    if (glyphSurface && glyphSurface->format->format != SDL_PIXELFORMAT_ARGB8888)
+        glyphSurface.reset(SDL_ConvertSurfaceFormat(glyphSurface.get(), SDL_PIXELFORMAT_ARGB8888, 0));
+    
+    if (!glyphSurface)
+    {
+        LOG_MESSAGE(Warning, "Unable to rasterize a glyph!")
+        LOG_MESSAGE(SDLFontError, "%s", TTF_GetError())
+        
+        return glyph;
+    }
+    
+    SDL_Point position;
+    
+    // One pixel of padding stops neighbouring glyphs bleeding into each other when filtered
+    if (!mPacker.pack(glyphSurface->w + 1, glyphSurface->h + 1, position))
+    {
+        LOG_MESSAGE(Warning, "The glyph atlas is full, glyph skipped!")
+        
+        return glyph;
+    }
+    
+    glyph.source = {position.x, position.y, glyphSurface->w, glyphSurface->h};
+    
+    SDL_UpdateTexture(mAtlasTexture->getTexture(), &glyph.source, glyphSurface->pixels, glyphSurface->pitch);
+    
+    return glyph;
+}
+
+int BitmapFont::findKerning(Uint16 previous, Uint16 current)
+{
+    if (!mUseKerning || previous == 0)
+        return 0;
+    
+    Uint32 pair = (static_cast<Uint32>(previous) << 16) | current;
+    
+    auto cachedKerning = mKerning.find(pair);
+    
+    if (cachedKerning != mKerning.end())
+        return cachedKerning->second;
+    
+    int kerning = TTF_GetFontKerningSizeGlyphs(mFont.get(), previous, current);
+    
+    mKerning[pair] = kerning;
+    
+    return kerning;
+}
+
+void BitmapFont::layoutText(const std::string &text, int wrapWidth, std::vector<PositionedGlyph> &glyphs, int &textWidth, int &textHeight)
+{
+    glyphs.clear();
+    
+    textWidth = 0;
+    textHeight = 0;
+    
+    if (!mFont)
+        return;
+    
+    decodeUTF8(text, mCodePointScratch);
+    
+    int penX = 0, penY = 0;
+    Uint16 previous = 0;
+    
+    // Glyph index and pen position just after the last space on the line, where the line may be broken
+    size_t breakGlyph = 0;
+    int breakPenX = -1;
+    
+    for (size_t i = 0; i < mCodePointScratch.size(); i++)
+    {
+        Uint16 codePoint = mCodePointScratch[i];
+        
+        if (codePoint == '\n')
+        {
+            textWidth = std::max(textWidth, penX);
+            
+            penX = 0;
+            penY += mLineSkip;
+            previous = 0;
+            breakPenX = -1;
+            
+            continue;
+        }
+        
+        Glyph &glyph = findGlyph(codePoint);
+        
+        penX += findKerning(previous, codePoint);
+        
+        // Past the wrap width, move everything after the last space down a line
+        if (wrapWidth > 0 && penX + glyph.advance > wrapWidth && breakPenX > 0 && codePoint != ' ')
+        {
+            textWidth = std::max(textWidth, breakPenX);
+            
+            int shift = breakPenX;
+            
+            penY += mLineSkip;
+            
+            for (size_t moved = breakGlyph; moved < glyphs.size(); moved++)
+            {
+                glyphs[moved].destination.x -= shift;
+                glyphs[moved].destination.y = penY;
+            }
+            
+            penX -= shift;
+            breakPenX = -1;
+        }
+        
+        if (glyph.source.w > 0)
+            glyphs.push_back({glyph.source, {penX, penY, glyph.source.w, glyph.source.h}});
+        
+        penX += glyph.advance;
+        previous = codePoint;
+        
+        if (codePoint == ' ')
+        {
+            breakGlyph = glyphs.size();
+            breakPenX = penX;
+        }
+    }
+    
+    textWidth = std::max(textWidth, penX);
+    textHeight = penY + mFontHeight;
+}
+
+void BitmapFont::drawText(SpriteBatch &spriteBatch, const std::string &text, int x, int y, SDL_Color textColor, int wrapWidth)
+{
+    if (!mAtlasTexture)
+        return;
+    
+    int textWidth, textHeight;
+    
+    layoutText(text, wrapWidth, mLayoutScratch, textWidth, textHeight);
+    
+    SDL_Texture *texture = mAtlasTexture->getTexture();
+    
+    // Every glyph comes from the same texture, so the whole string ends up in one batch
+    for (const PositionedGlyph &glyph : mLayoutScratch)
+    {
+        SDL_FRect destination {static_cast<float>(x + glyph.destination.x), static_cast<float>(y + glyph.destination.y), static_cast<float>(glyph.destination.w), static_cast<float>(glyph.destination.h)};
+        
+        spriteBatch.draw(texture, mAtlasTexture->getWidth(), mAtlasTexture->getHeight(), glyph.source, destination, 0.0, SDL_FLIP_NONE, textColor);
+    }
+}
+
+void BitmapFont::measureText(const std::string &text, int wrapWidth, int &textWidth, int &textHeight)
+{
+    layoutText(text, wrapWidth, mLayoutScratch, textWidth, textHeight);
+}
+
+int BitmapFont::getLineSkip()
+{
+    return mLineSkip;
+}
+
+std::shared_ptr<TextureAsset> BitmapFont::getAtlasTexture()
+{
+    return mAtlasTexture;
+}
+
+namespace FontCache
+{
+    std::shared_ptr<BitmapFont> loadFont(std::string fontPath, int pointSize, std::shared_ptr<SDL_Renderer> &renderer)
+    {
+        std::string key = fontPath + '@' + std::to_string(pointSize) + '@' + std::to_string(reinterpret_cast<uintptr_t>(renderer.get()));
+        
+        // Hand out the existing font if anything is still holding on to it
+        auto cachedFont = mFontCache.find(key);
+        
+        if (cachedFont != mFontCache.end())
+        {
+            if (std::shared_ptr<BitmapFont> sharedFont = cachedFont->second.lock())
+                return sharedFont;
+        }
+        
+        std::shared_ptr<BitmapFont> sharedFont = std::make_shared<BitmapFont>();
+        
+        if (!sharedFont->init(fontPath, pointSize, renderer))
+            return nullptr;
+        
+        mFontCache[key] = sharedFont;
+        
+        return sharedFont;
+    }
+    
+    void clearFontCache()
+    {
+        mFontCache.clear();
+    }
+}
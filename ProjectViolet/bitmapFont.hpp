@@ -0,0 +1,116 @@
+//
+//  bitmapFont.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef bitmapFont_hpp
+#define bitmapFont_hpp
+
+#include <array>
+#include <memory>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "assetManager.hpp"
+#include "packArchive.hpp"
+#include "spriteBatch.hpp"
+#include "textureAtlas.hpp"
+
+// A glyph placed by BitmapFont::layoutText(...), relative to the text's top left corner
+struct PositionedGlyph
+{
+    // Where the glyph's image is in the font's atlas
+    SDL_Rect source;
+    
+    // Where the glyph lands
+    SDL_Rect destination;
+};
+
+// A font at one point size whose glyphs are rasterized once into an atlas and drawn as batched quads
+class BitmapFont
+{
+public:
+    // Initializes an empty font
+    BitmapFont();
+    
+    // Closes the font and releases its atlas
+    ~BitmapFont();
+    
+    // Opens the font and rasterizes the printable ASCII range into its atlas
+    bool init(std::string fontPath, int pointSize, std::shared_ptr<SDL_Renderer> &renderer, int atlasSize = 1024);
+    
+    // Positions the glyphs of a UTF-8 string, wrapping on spaces past wrapWidth (0 disables wrapping)
+    void layoutText(const std::string &text, int wrapWidth, std::vector<PositionedGlyph> &glyphs, int &textWidth, int &textHeight);
+    
+    // Queues a string's glyphs in a sprite batch without creating any surfaces or textures
+    void drawText(SpriteBatch &spriteBatch, const std::string &text, int x, int y, SDL_Color textColor = {0xFF, 0xFF, 0xFF, 0xFF}, int wrapWidth = 0);
+    
+    // Returns the size a string would take up when drawn
+    void measureText(const std::string &text, int wrapWidth, int &textWidth, int &textHeight);
+    
+    // Returns the distance between the tops of two lines
+    int getLineSkip();
+    
+    // Returns the atlas texture holding the rasterized glyphs
+    std::shared_ptr<TextureAsset> getAtlasTexture();
+
+private:
+    // A rasterized glyph and its metrics
+    struct Glyph
+    {
+        SDL_Rect source;
+        int advance;
+        bool loaded;
+    };
+    
+    // Returns the glyph for a code point, rasterizing it into the atlas the first time it is used
+    Glyph& findGlyph(Uint16 codePoint);
+    
+    // Returns the kerning between two code points, caching what FreeType reports
+    int findKerning(Uint16 previous, Uint16 current);
+    
+    // Pointer to the renderer so that it doesn't have to be passed when glyphs are added
+    std::shared_ptr<SDL_Renderer> mRenderer;
+    
+    // FreeType reads the font file for as long as it is open, so its bytes are kept here
+    PackEntry mFontData;
+    
+    std::unique_ptr<TTF_Font, decltype(&TTF_CloseFont)> mFont;
+    
+    // Every glyph of the font shares this texture
+    std::shared_ptr<TextureAsset> mAtlasTexture;
+    
+    SkylinePacker mPacker;
+    
+    // ASCII glyphs are looked up directly, everything else through the map
+    std::array<Glyph, 128> mAsciiGlyphs;
+    std::unordered_map<Uint16, Glyph> mExtendedGlyphs;
+    
+    std::unordered_map<Uint32, int> mKerning;
+    
+    // Reused between calls so drawing text doesn't allocate
+    std::vector<PositionedGlyph> mLayoutScratch;
+    std::vector<Uint16> mCodePointScratch;
+    
+    int mLineSkip, mFontHeight;
+    
+    bool mUseKerning;
+};
+
+namespace FontCache
+{
+    // Returns the shared bitmap font for a font file and size, only rasterizing it if no live copy exists
+    std::shared_ptr<BitmapFont> loadFont(std::string fontPath, int pointSize, std::shared_ptr<SDL_Renderer> &renderer);
+    
+    // Forgets every cached font, must be called before the renderer is destroyed
+    void clearFontCache();
+}
+
+#endif /* bitmapFont_hpp */
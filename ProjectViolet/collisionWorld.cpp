@@ -0,0 +1,430 @@
+//
+//  collisionWorld.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "collisionWorld.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VIOLET_X86_KERNELS
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define VIOLET_NEON_KERNELS
+#endif
+
+namespace
+{
+    // The sorted arrays end in this many boxes that can't overlap anything, so a sweep never reads past them
+    const Uint32 SWEEP_PADDING = 4;
+    
+    typedef void (*SweepKernel)(const float *minX, const float *minY, const float *maxX, const float *maxY, Uint32 count, std::vector<Uint32> &pairs);
+    
+    // Boxes sharing only an edge don't overlap, the same as SDL_HasIntersection
+    void sweepScalar(const float *minX, const float *minY, const float *maxX, const float *maxY, Uint32 count, std::vector<Uint32> &pairs)
+    {
+        for (Uint32 i = 0; i < count; i++)
+        {
+            // Everything after the first box starting right of this one starts right of it too
+            for (Uint32 j = i + 1; minX[j] < maxX[i]; j++)
+            {
+                if (minX[i] < maxX[j] && minY[j] < maxY[i] && minY[i] < maxY[j])
+                {
+                    pairs.push_back(i);
+                    pairs.push_back(j);
+                }
+            }
+        }
+    }
+
+#ifdef VIOLET_X86_KERNELS
+    void sweepSSE2(const float *minX, const float *minY, const float *maxX, const float *maxY, Uint32 count, std::vector<Uint32> &pairs)
+    {
+        for (Uint32 i = 0; i < count; i++)
+        {
+            const __m128 boxMinX = _mm_set1_ps(minX[i]);
+            const __m128 boxMinY = _mm_set1_ps(minY[i]);
+            const __m128 boxMaxX = _mm_set1_ps(maxX[i]);
+            const __m128 boxMaxY = _mm_set1_ps(maxY[i]);
+            
+            // Tests the next four boxes at once until one of them starts right of this box
+            for (Uint32 j = i + 1;; j += 4)
+            {
+                int startsInside = _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(minX + j), boxMaxX));
+                
+                if (startsInside == 0)
+                    break;
+                
+                __m128 overlaps = _mm_and_ps(_mm_cmplt_ps(boxMinX, _mm_loadu_ps(maxX + j)), _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minY + j), boxMaxY), _mm_cmplt_ps(boxMinY, _mm_loadu_ps(maxY + j))));
+                
+                int overlapMask = _mm_movemask_ps(overlaps) & startsInside;
+                
+                for (int lane = 0; overlapMask != 0; lane++, overlapMask >>= 1)
+                {
+                    if (overlapMask & 1)
+                    {
+                        pairs.push_back(i);
+                        pairs.push_back(j + lane);
+                    }
+                }
+                
+                // Sorted, so once one lane starts right of the box every later box does too
+                if (startsInside != 0xF)
+                    break;
+            }
+        }
+    }
+#endif
+
+#ifdef VIOLET_NEON_KERNELS
+    // NEON has no movemask, so lanes are reduced to the same bit per lane as SSE's
+    inline Uint32 laneMask(uint32x4_t lanes)
+    {
+        static const uint32x4_t laneBits = {1, 2, 4, 8};
+        
+        return vaddvq_u32(vandq_u32(lanes, laneBits));
+    }
+    
+    void sweepNEON(const float *minX, const float *minY, const float *maxX, const float *maxY, Uint32 count, std::vector<Uint32> &pairs)
+    {
+        for (Uint32 i = 0; i < count; i++)
+        {
+            const float32x4_t boxMinX = vdupq_n_f32(minX[i]);
+            const float32x4_t boxMinY = vdupq_n_f32(minY[i]);
+            const float32x4_t boxMaxX = vdupq_n_f32(maxX[i]);
+            const float32x4_t boxMaxY = vdupq_n_f32(maxY[i]);
+            
+            for (Uint32 j = i + 1;; j += 4)
+            {
+                Uint32 startsInside = laneMask(vcltq_f32(vld1q_f32(minX + j), boxMaxX));
+                
+                if (startsInside == 0)
+                    break;
+                
+                uint32x4_t overlaps = vandq_u32(vcltq_f32(boxMinX, vld1q_f32(maxX + j)), vandq_u32(vcltq_f32(vld1q_f32(minY + j), boxMaxY), vcltq_f32(boxMinY, vld1q_f32(maxY + j))));
+                
+                Uint32 overlapMask = laneMask(overlaps) & startsInside;
+                
+                for (Uint32 lane = 0; overlapMask != 0; lane++, overlapMask >>= 1)
+                {
+                    if (overlapMask & 1)
+                    {
+                        pairs.push_back(i);
+                        pairs.push_back(j + lane);
+                    }
+                }
+                
+                if (startsInside != 0xF)
+                    break;
+            }
+        }
+    }
+#endif
+
+    SweepKernel findSweepKernel(CollisionWorld::Kernel kernel)
+    {
+#ifdef VIOLET_X86_KERNELS
+        if (kernel == CollisionWorld::Kernel::SSE2)
+            return sweepSSE2;
+#endif
+
+#ifdef VIOLET_NEON_KERNELS
+        if (kernel == CollisionWorld::Kernel::NEON)
+            return sweepNEON;
+#endif
+
+        return sweepScalar;
+    }
+}
+
+CollisionWorld::CollisionWorld() : mKernel(getBestKernel()), mStep(0), mNewBodies(0)
+{
+    
+}
+
+CollisionWorld::Kernel CollisionWorld::getBestKernel()
+{
+#ifdef VIOLET_X86_KERNELS
+    if (SDL_HasSSE2())
+        return Kernel::SSE2;
+#endif
+
+#ifdef VIOLET_NEON_KERNELS
+    if (SDL_HasNEON())
+        return Kernel::NEON;
+#endif
+
+    return Kernel::Scalar;
+}
+
+void CollisionWorld::setKernel(Kernel kernel)
+{
+    // Each CPU supports at most one of the vector kernels, so anything but scalar means the best one
+    mKernel = kernel == Kernel::Scalar ? Kernel::Scalar : getBestKernel();
+}
+
+CollisionWorld::Kernel CollisionWorld::getKernel()
+{
+    return mKernel;
+}
+
+const char* CollisionWorld::getKernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+        case Kernel::NEON:
+            return "neon";
+        
+        case Kernel::SSE2:
+            return "sse2";
+        
+        default:
+            return "scalar";
+    }
+}
+
+void CollisionWorld::update(Entity entity, float minX, float minY, float maxX, float maxY)
+{
+    if (entity.index >= mBodyOfEntity.size())
+        mBodyOfEntity.resize(entity.index + 1, INVALID_BODY);
+    
+    Uint32 body = mBodyOfEntity[entity.index];
+    
+    // A previous entity in the same slot is left to be dropped as stale
+    if (body == INVALID_BODY || mEntities[body] != entity)
+    {
+        body = static_cast<Uint32>(mEntities.size());
+        
+        mEntities.push_back(entity);
+        mMinX.push_back(minX);
+        mMinY.push_back(minY);
+        mMaxX.push_back(maxX);
+        mMaxY.push_back(maxY);
+        mUpdateStamps.push_back(mStep);
+        
+        // New bodies start at the end of the order and are sorted into place with everything else
+        mOrder.push_back(body);
+        mNewBodies++;
+        
+        mBodyOfEntity[entity.index] = body;
+        
+        return;
+    }
+    
+    mMinX[body] = minX;
+    mMinY[body] = minY;
+    mMaxX[body] = maxX;
+    mMaxY[body] = maxY;
+    mUpdateStamps[body] = mStep;
+}
+
+bool CollisionWorld::contains(Entity entity)
+{
+    return entity.index < mBodyOfEntity.size() && mBodyOfEntity[entity.index] != INVALID_BODY && mEntities[mBodyOfEntity[entity.index]] == entity;
+}
+
+const std::vector<Contact>& CollisionWorld::findContacts()
+{
+    PROFILE_ZONE("CollisionWorld::findContacts")
+    
+    removeStaleBodies();
+    sortBodies();
+    
+    mPairs.clear();
+    
+    {
+        PROFILE_ZONE("CollisionWorld::sweep")
+        
+        findSweepKernel(mKernel)(mSortedMinX.data(), mSortedMinY.data(), mSortedMaxX.data(), mSortedMaxY.data(), static_cast<Uint32>(mOrder.size()), mPairs);
+    }
+    
+    mContacts.clear();
+    
+    for (size_t i = 0; i < mPairs.size(); i += 2)
+        addContact(mOrder[mPairs[i]], mOrder[mPairs[i + 1]]);
+    
+    // Bodies have to be updated again before the next sweep to stay in the world
+    mStep++;
+    
+    PROFILE_COUNTER("Collision bodies", mOrder.size())
+    PROFILE_COUNTER("Contacts", mContacts.size())
+    
+    return mContacts;
+}
+
+const std::vector<Contact>& CollisionWorld::getContacts()
+{
+    return mContacts;
+}
+
+size_t CollisionWorld::size()
+{
+    return mEntities.size();
+}
+
+void CollisionWorld::removeStaleBodies()
+{
+    size_t bodyCount = mEntities.size();
+    
+    Uint32 liveCount = 0;
+    
+    for (size_t body = 0; body < bodyCount; body++)
+    {
+        if (mUpdateStamps[body] == mStep)
+            liveCount++;
+    }
+    
+    if (liveCount == bodyCount)
+        return;
+    
+    mRemap.resize(bodyCount);
+    
+    // Compact the live bodies towards the front, remembering where each one went
+    Uint32 next = 0;
+    
+    for (Uint32 body = 0; body < bodyCount; body++)
+    {
+        Uint32 &entityBody = mBodyOfEntity[mEntities[body].index];
+        
+        if (mUpdateStamps[body] != mStep)
+        {
+            mRemap[body] = INVALID_BODY;
+            
+            // The slot may already belong to a newer entity's body
+            if (entityBody == body)
+                entityBody = INVALID_BODY;
+            
+            continue;
+        }
+        
+        mRemap[body] = next;
+        entityBody = next;
+        
+        mEntities[next] = mEntities[body];
+        mMinX[next] = mMinX[body];
+        mMinY[next] = mMinY[body];
+        mMaxX[next] = mMaxX[body];
+        mMaxY[next] = mMaxY[body];
+        mUpdateStamps[next] = mUpdateStamps[body];
+        
+        next++;
+    }
+    
+    mEntities.resize(liveCount);
+    mMinX.resize(liveCount);
+    mMinY.resize(liveCount);
+    mMaxX.resize(liveCount);
+    mMaxY.resize(liveCount);
+    mUpdateStamps.resize(liveCount);
+    
+    // Filtering the order keeps it sorted
+    size_t orderCount = 0;
+    
+    for (Uint32 body : mOrder)
+    {
+        if (mRemap[body] != INVALID_BODY)
+            mOrder[orderCount++] = mRemap[body];
+    }
+    
+    mOrder.resize(orderCount);
+}
+
+void CollisionWorld::sortBodies()
+{
+    PROFILE_ZONE("CollisionWorld::sortBodies")
+    
+    auto leftOf = [this](Uint32 first, Uint32 second)
+    {
+        return mMinX[first] < mMinX[second];
+    };
+    
+    if (mNewBodies > INSERTION_SORT_LIMIT)
+    {
+        std::sort(mOrder.begin(), mOrder.end(), leftOf);
+    }
+    else
+    {
+        // Last step's order is almost right, so each body only moves past the few it overtook
+        for (size_t i = 1; i < mOrder.size(); i++)
+        {
+            Uint32 body = mOrder[i];
+            size_t j = i;
+            
+            for (; j > 0 && leftOf(body, mOrder[j - 1]); j--)
+                mOrder[j] = mOrder[j - 1];
+            
+            mOrder[j] = body;
+        }
+    }
+    
+    mNewBodies = 0;
+    
+    size_t sortedCount = mOrder.size() + SWEEP_PADDING;
+    
+    mSortedMinX.resize(sortedCount);
+    mSortedMinY.resize(sortedCount);
+    mSortedMaxX.resize(sortedCount);
+    mSortedMaxY.resize(sortedCount);
+    
+    for (size_t i = 0; i < mOrder.size(); i++)
+    {
+        Uint32 body = mOrder[i];
+        
+        mSortedMinX[i] = mMinX[body];
+        mSortedMinY[i] = mMinY[body];
+        mSortedMaxX[i] = mMaxX[body];
+        mSortedMaxY[i] = mMaxY[body];
+    }
+    
+    // Padding starts infinitely far right, which ends every sweep that reaches it
+    for (size_t i = mOrder.size(); i < sortedCount; i++)
+    {
+        mSortedMinX[i] = std::numeric_limits<float>::infinity();
+        mSortedMinY[i] = std::numeric_limits<float>::infinity();
+        mSortedMaxX[i] = std::numeric_limits<float>::infinity();
+        mSortedMaxY[i] = std::numeric_limits<float>::infinity();
+    }
+}
+
+void CollisionWorld::addContact(Uint32 first, Uint32 second)
+{
+    // Lower entity index first, so a pair always comes out the same way round
+    if (mEntities[second].index < mEntities[first].index)
+        std::swap(first, second);
+    
+    float overlapX = std::min(mMaxX[first], mMaxX[second]) - std::max(mMinX[first], mMinX[second]);
+    float overlapY = std::min(mMaxY[first], mMaxY[second]) - std::max(mMinY[first], mMinY[second]);
+    
+    // Centers compared as sums, the halves cancel out
+    float directionX = (mMinX[second] + mMaxX[second]) - (mMinX[first] + mMaxX[first]);
+    float directionY = (mMinY[second] + mMaxY[second]) - (mMinY[first] + mMaxY[first]);
+    
+    Contact contact;
+    
+    contact.first = mEntities[first];
+    contact.second = mEntities[second];
+    
+    if (overlapX < overlapY)
+    {
+        contact.normalX = directionX < 0.0f ? -1.0f : 1.0f;
+        contact.normalY = 0.0f;
+        contact.depth = overlapX;
+    }
+    else
+    {
+        contact.normalX = 0.0f;
+        contact.normalY = directionY < 0.0f ? -1.0f : 1.0f;
+        contact.depth = overlapY;
+    }
+    
+    mContacts.push_back(contact);
+}
@@ -0,0 +1,112 @@
+//
+//  collisionWorld.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef collisionWorld_hpp
+#define collisionWorld_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+#include "entityRegistry.hpp"
+
+// Two overlapping colliders, the normal points from first to second along the axis they overlap least on
+struct Contact
+{
+    Entity first, second;
+    float normalX, normalY;
+    float depth;
+};
+
+// Finds every pair of overlapping boxes with sort and sweep, bodies stay sorted by their left edge between steps,
+// so while they only move a little per step keeping them sorted is close to linear
+class CollisionWorld
+{
+public:
+    // Sweep kernels, a vector kernel is only used if the CPU supports it
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        NEON
+    };
+    
+    // Initializes an empty world using the fastest kernel
+    CollisionWorld();
+    
+    // Returns the fastest kernel this CPU supports
+    static Kernel getBestKernel();
+    
+    // Forces a kernel for the following sweeps, unsupported kernels fall back to the best supported one
+    void setKernel(Kernel kernel);
+    
+    // Returns the kernel sweeps currently use
+    Kernel getKernel();
+    
+    // Returns the kernel's name for logs and benchmark results
+    static const char* getKernelName(Kernel kernel);
+    
+    // Adds the entity's box or moves it, bodies not updated since the last findContacts() are dropped by the next one
+    void update(Entity entity, float minX, float minY, float maxX, float maxY);
+    
+    // Returns whether the entity (this generation of it) has a body
+    bool contains(Entity entity);
+    
+    // Sorts and sweeps the bodies and returns each overlapping pair once, the result is reused by the next call
+    const std::vector<Contact>& findContacts();
+    
+    // Returns the pairs found by the last findContacts()
+    const std::vector<Contact>& getContacts();
+    
+    // Returns the number of bodies
+    size_t size();
+    
+    // Past this many new bodies in a step a full sort beats moving each of them into place
+    static const size_t INSERTION_SORT_LIMIT = 64;
+
+private:
+    static constexpr Uint32 INVALID_BODY = 0xFFFFFFFF;
+    
+    // Drops the bodies that weren't updated this step, keeping the others in their sorted order
+    void removeStaleBodies();
+    
+    // Brings mOrder back into left edge order and copies the bounds into the sorted arrays the kernels sweep
+    void sortBodies();
+    
+    // Narrowphase for a pair of bodies, whose boxes are known to overlap
+    void addContact(Uint32 first, Uint32 second);
+    
+    Kernel mKernel;
+    
+    // Bodies are indexed by entity slot, so lookups never hash
+    std::vector<Uint32> mBodyOfEntity;
+    
+    // Body bounds as separate arrays, so the kernels load four boxes' worth of one edge at a time
+    std::vector<Entity> mEntities;
+    std::vector<float> mMinX, mMinY, mMaxX, mMaxY;
+    
+    // Step each body was last updated in
+    std::vector<Uint32> mUpdateStamps;
+    Uint32 mStep;
+    
+    // Bodies sorted by their left edge, kept from step to step
+    std::vector<Uint32> mOrder;
+    size_t mNewBodies;
+    
+    // Bounds in sorted order, padded so the kernels can always load four boxes
+    std::vector<float> mSortedMinX, mSortedMinY, mSortedMaxX, mSortedMaxY;
+    
+    // Overlapping pairs as positions in the sorted arrays, two entries per pair
+    std::vector<Uint32> mPairs;
+    
+    std::vector<Uint32> mRemap;
+    
+    std::vector<Contact> mContacts;
+};
+
+#endif /* collisionWorld_hpp */
@@ -0,0 +1,50 @@
+//
+//  components.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef components_hpp
+#define components_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+
+#include "assetManager.hpp"
+
+// Position in world pixels, the previous position is kept so rendering can interpolate between updates
+struct Transform
+{
+    float x, y;
+    float previousX, previousY;
+    float angle;
+};
+
+// Movement in world pixels per second
+struct Velocity
+{
+    float x, y;
+};
+
+// An axis aligned box that collides with other colliders, offset from the entity's position and unaffected by its angle
+struct Collider
+{
+    float offsetX, offsetY;
+    float width, height;
+};
+
+// A textured quad drawn at the entity's transform
+struct Sprite
+{
+    std::shared_ptr<TextureAsset> texture;
+    SDL_Rect source;
+    int width, height;
+    int layer;
+    SDL_Color colorModulation;
+    SDL_BlendMode blendMode;
+};
+
+#endif /* components_hpp */
@@ -8,83 +8,324 @@
 
 #include "debug.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    // A queued message, formatted in place so logging never allocates
+    struct LogRecord
+    {
+        // Vyukov style sequence number telling producers and the consumer whose turn the slot is
+        std::atomic<unsigned long> sequence;
+        
+        MessageSeverity severity;
+        int line;
+        const char *fileName;
+        char message[Debug::MAX_MESSAGE_LENGTH];
+    };
+    
+    // Bounded lock-free multi-producer, single-consumer queue drained by the logging thread
+    class LogQueue
+    {
+    public:
+        LogQueue() : mEnqueuePosition(0), mDequeuePosition(0)
+        {
+            for (unsigned long i = 0; i < Debug::LOG_QUEUE_CAPACITY; i++)
+                mRecords[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        
+        // Claims a free slot, returns nullptr instead of waiting when the queue is full
+        LogRecord* claim()
+        {
+            unsigned long position = mEnqueuePosition.load(std::memory_order_relaxed);
+            
+            while (true)
+            {
+                LogRecord &record = mRecords[position % Debug::LOG_QUEUE_CAPACITY];
+                long difference = static_cast<long>(record.sequence.load(std::memory_order_acquire)) - static_cast<long>(position);
+                
+                if (difference == 0)
+                {
+                    if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        return &record;
+                }
+                else if (difference < 0)
+                {
+                    return nullptr;
+                }
+                else
+                {
+                    position = mEnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        
+        // Hands a filled slot over to the consumer
+        void publish(LogRecord *record)
+        {
+            unsigned long position = record->sequence.load(std::memory_order_relaxed);
+            
+            record->sequence.store(position + 1, std::memory_order_release);
+        }
+        
+        // Returns the next published record, or nullptr if there is none yet
+        LogRecord* peek()
+        {
+            LogRecord &record = mRecords[mDequeuePosition % Debug::LOG_QUEUE_CAPACITY];
+            
+            if (record.sequence.load(std::memory_order_acquire) != mDequeuePosition + 1)
+                return nullptr;
+            
+            return &record;
+        }
+        
+        // Returns the consumed record's slot to the producers
+        void release(LogRecord *record)
+        {
+            record->sequence.store(mDequeuePosition + Debug::LOG_QUEUE_CAPACITY, std::memory_order_release);
+            mDequeuePosition++;
+        }
+        
+        // Returns whether every claimed slot has been consumed
+        bool isDrained()
+        {
+            return mEnqueuePosition.load(std::memory_order_acquire) == mDequeuePositionShared.load(std::memory_order_acquire);
+        }
+        
+        // Lets other threads see how far the consumer has got
+        void shareDequeuePosition()
+        {
+            mDequeuePositionShared.store(mDequeuePosition, std::memory_order_release);
+        }
+        
+    private:
+        LogRecord mRecords[Debug::LOG_QUEUE_CAPACITY];
+        
+        // Producers and the consumer work on different cache lines
+        alignas(64) std::atomic<unsigned long> mEnqueuePosition;
+        alignas(64) unsigned long mDequeuePosition;
+        std::atomic<unsigned long> mDequeuePositionShared;
+    };
+    
+    // Owns the logging thread, which lives from the first message until the program exits
+    class LogWriter
+    {
+    public:
+        LogWriter() : droppedMessages(0), mRunning(true), mThread(&LogWriter::drainLoop, this)
+        {
+            
+        }
+        
+        ~LogWriter()
+        {
+            mRunning.store(false, std::memory_order_release);
+            mThread.join();
+        }
+        
+        LogQueue queue;
+        
+        // Guards the output stream, only ever taken by the logging thread and the file functions
+        std::mutex outputMutex;
+        
+        // Stores the cout buffer before switching between file and console output mode
+        std::streambuf *baseCoutBuffer = nullptr;
+        
+        // Stores the console output file
+        std::fstream outputFile;
+        
+        std::atomic<unsigned long> droppedMessages;
+        
+    private:
+        void drainLoop()
+        {
+            bool running = true;
+            
+            while (running)
+            {
+                // Read the flag before draining so nothing queued before shutdown is lost
+                running = mRunning.load(std::memory_order_acquire);
+                
+                if (!drain())
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        
+        // Writes every published record, returns whether there were any
+        bool drain()
+        {
+            LogRecord *record = queue.peek();
+            
+            if (record == nullptr)
+                return false;
+            
+            std::lock_guard<std::mutex> lock(outputMutex);
+            
+            std::ostream &output = outputFile.is_open() ? static_cast<std::ostream&>(outputFile) : std::cerr;
+            
+            for (; record != nullptr; record = queue.peek())
+            {
+                output << severityLabel(record->severity) << "on line " << record->line << " of " << record->fileName << (record->fileName[0] != '\0' ? ": " : "") << record->message << '\n';
+                
+                queue.release(record);
+            }
+            
+            unsigned long dropped = droppedMessages.exchange(0, std::memory_order_relaxed);
+            
+            if (dropped > 0)
+                output << "SEVERE WARNING " << dropped << " log messages were dropped because the log queue was full\n";
+            
+            output.flush();
+            
+            queue.shareDequeuePosition();
+            
+            return true;
+        }
+        
+        static const char* severityLabel(MessageSeverity severity)
+        {
+            switch (severity)
+            {
+                case Information:
+                    return "Message ";
+                    
+                case Warning:
+                    return "Warning ";
+                    
+                case SevereWarning:
+                    return "SEVERE WARNING ";
+                    
+                case Error:
+                    return "Error ";
+                    
+                case SevereError:
+                    return "SEVERE ERROR ";
+                    
+                case IrrecoverableError:
+                    return "IRRECOVERABLE ERROR ";
+                    
+                case SDLError:
+                    return "SDL Error ";
+                    
+                case SDLImageError:
+                    return "SDL_image Error ";
+                    
+                case SDLFontError:
+                    return "SDL_ttf Error ";
+                    
+                case SDLMixerError:
+                    return "SDL_mixer Error ";
+            }
+            
+            return "";
+        }
+        
+        std::atomic<bool> mRunning;
+        
+        std::thread mThread;
+    };
+    
+    // Started on first use so logging during static initialization still works
+    LogWriter& logWriter()
+    {
+        static LogWriter writer;
+        
+        return writer;
+    }
+}
 
 namespace Debug
 {
     void startLoggingToFile()
     {
+        std::lock_guard<std::mutex> lock(logWriter().outputMutex);
+        
         // Create a file with the current date as the title for debug output logging
-        mOutputFile.open(__DATE__, std::fstream::out | std::fstream::app);
+        logWriter().outputFile.open(__DATE__, std::fstream::out | std::fstream::app);
         
-        // Store the output files buffer in a temporary variable
-        std::streambuf* tempbuf = mOutputFile.rdbuf();
         // Redirect cout buffer to the output file, and store the original in a variable
-        mBaseCoutBuffer = std::cout.rdbuf(tempbuf);
+        logWriter().baseCoutBuffer = std::cout.rdbuf(logWriter().outputFile.rdbuf());
         
         // Mark the start logging time in the file
         std::cout << '[' <<  __TIMESTAMP__ << "]\n";
-        
-        // Erase the contents of tempbuf to avoid wild pointers
-        tempbuf = nullptr;
     }
-
+    
     void stopLoggingToFile()
     {
+        // Write out anything still queued for the file first
+        flushLog();
+        
+        std::lock_guard<std::mutex> lock(logWriter().outputMutex);
+        
         // Restore the original cout buffer
-        std::cout.rdbuf(mBaseCoutBuffer);
+        std::cout.rdbuf(logWriter().baseCoutBuffer);
         
         // Close the output file as it is no longer needed
-        mOutputFile.close();
+        logWriter().outputFile.close();
     }
-
-    void logMessage(std::string message, MessageSeverity severity, int line, std::string fileName)
+    
+    void flushLog()
+    {
+        while (!logWriter().queue.isDrained())
+            std::this_thread::yield();
+    }
+    
+    unsigned long getDroppedMessageCount()
+    {
+        return logWriter().droppedMessages.load(std::memory_order_relaxed);
+    }
+    
+    void logFormatted(MessageSeverity severity, int line, const char *fileName, const char *format, ...)
     {
+        va_list arguments;
+        va_start(arguments, format);
+        
         // Irrecoverable errors are the only error to interrupt the program, as it should only be used when
         // it is not safe to continue the program any longer
-        switch (severity)
+        if (severity == IrrecoverableError)
         {
-            case Information:
-                std::cerr << "Message ";
-                break;
-                
-            case Warning:
-                std::cerr << "Warning ";
-                break;
-                
-            case SevereWarning:
-                std::cerr << "SEVERE WARNING ";
-                break;
-                
-            case Error:
-                std::cerr << "Error ";
-                break;
-                
-            case SevereError:
-                std::cerr << "SEVERE ERROR ";
-                break;
-                
-            case SDLError:
-                std::cerr << "SDL Error ";
-                break;
-                
-            case SDLImageError:
-                std::cerr << "SDL_image Error ";
-                break;
-                
-            case SDLFontError:
-                std::cerr << "SDL_ttf Error ";
-                break;
-                
-            case SDLMixerError:
-                std::cerr << "SDL_mixer Error ";
-                break;
-                
-            case IrrecoverableError:
-                throw std::runtime_error("IRRECOVERABLE ERROR on line " + std::to_string(line) + " of " + fileName + ": " + message + '\n');
-                break;
+            char message[MAX_MESSAGE_LENGTH];
+            
+            vsnprintf(message, sizeof(message), format, arguments);
+            va_end(arguments);
+            
+            // Make sure everything leading up to the error has been written
+            flushLog();
+            
+            throw std::runtime_error("IRRECOVERABLE ERROR on line " + std::to_string(line) + " of " + fileName + ": " + message + '\n');
+        }
+        
+        LogWriter &writer = logWriter();
+        LogRecord *record = writer.queue.claim();
+        
+        // Never block the caller, count the message and move on
+        if (record == nullptr)
+        {
+            writer.droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            va_end(arguments);
+            
+            return;
         }
         
-        std::cerr << "on line " << line << " of " << fileName << ": " << message << '\n';
+        record->severity = severity;
+        record->line = line;
+        record->fileName = fileName;
+        
+        vsnprintf(record->message, sizeof(record->message), format, arguments);
+        va_end(arguments);
+        
+        writer.queue.publish(record);
+    }
+    
+    void logMessage(const std::string &message, MessageSeverity severity, int line, const std::string &fileName)
+    {
+        // The file name has to outlive the queued record, so it is copied into the message instead
+        logFormatted(severity, line, "", "%s: %s", fileName.c_str(), message.c_str());
     }
 }
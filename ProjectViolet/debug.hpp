@@ -9,7 +9,6 @@
 #ifndef debug_hpp
 #define debug_hpp
 
-#include <fstream>
 #include <stdio.h>
 #include <string>
 
@@ -33,25 +32,49 @@ enum MessageSeverity
     SDLMixerError
 };
 
-namespace
-{
-    // Stores the cout buffer before switching between file and console output mode
-    std::streambuf* mBaseCoutBuffer = nullptr;
-    
-    // Stores the console output file
-    std::fstream mOutputFile;
-}
+// Messages below this severity are compiled out entirely, release builds keep only what interrupts the program
+#ifndef DEBUG_MIN_SEVERITY
+#ifndef NDEBUG
+#define DEBUG_MIN_SEVERITY Information
+#else
+#define DEBUG_MIN_SEVERITY IrrecoverableError
+#endif
+#endif
+
+// Logs a printf style message with the call site's line and file, without building any strings at the call site
+#define LOG_MESSAGE(severity, ...) do { if constexpr (Debug::severityRank(severity) >= Debug::severityRank(DEBUG_MIN_SEVERITY)) Debug::logFormatted(severity, __LINE__, __FILE_NAME__, __VA_ARGS__); } while (0);
 
 namespace Debug
 {
+    // Longest message kept, anything longer is truncated
+    const int MAX_MESSAGE_LENGTH = 224;
+    
+    // Number of messages that can wait for the logging thread before new ones are dropped
+    const int LOG_QUEUE_CAPACITY = 1024;
+    
+    // Orders severities for filtering, library errors count as plain errors
+    constexpr int severityRank(MessageSeverity severity)
+    {
+        return severity >= SDLError ? static_cast<int>(Error) : static_cast<int>(severity);
+    }
+    
     // Utility function that starts console output logging
     void startLoggingToFile();
     
     // Utility function that ends console output logging
     void stopLoggingToFile();
     
+    // Blocks until every queued message has been written
+    void flushLog();
+    
+    // Returns how many messages were dropped because the queue was full
+    unsigned long getDroppedMessageCount();
+    
+    // Formats a message straight into the logging queue, irrecoverable errors throw instead
+    void logFormatted(MessageSeverity severity, int line, const char *fileName, const char *format, ...) __attribute__((format(printf, 4, 5)));
+    
     // Utility function for logging messages to the console from outside the application class
-    void logMessage(std::string message, MessageSeverity severity, int line, std::string fileName);
+    void logMessage(const std::string &message, MessageSeverity severity, int line, const std::string &fileName);
 }
 
 #endif /* debug_hpp */
@@ -0,0 +1,93 @@
+//
+//  dirtyRegions.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "dirtyRegions.hpp"
+
+DirtyRegions::DirtyRegions(int maxRegions) : mBounds({0, 0, 0, 0}), mMaxRegions(maxRegions), mFullyDirty(true), mLastRegionCount(0)
+{
+    mRegions.reserve(maxRegions + 1);
+}
+
+void DirtyRegions::setBounds(int width, int height)
+{
+    mBounds = {0, 0, width, height};
+    
+    markAll();
+}
+
+void DirtyRegions::mark(const SDL_Rect &rect)
+{
+    if (mFullyDirty)
+        return;
+    
+    SDL_Rect region;
+    
+    // Anything off screen was never drawn and never will be
+    if (!SDL_IntersectRect(&rect, &mBounds, &region))
+        return;
+    
+    // Merging can make the region overlap ones it was already checked against, so the scan restarts after every merge
+    for (size_t i = 0; i < mRegions.size();)
+    {
+        if (SDL_HasIntersection(&mRegions[i], &region))
+        {
+            SDL_UnionRect(&mRegions[i], &region, &region);
+            
+            mRegions[i] = mRegions.back();
+            mRegions.pop_back();
+            
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    
+    mRegions.push_back(region);
+    
+    // Past a handful of rectangles the clipping costs more than drawing everything once
+    if (static_cast<int>(mRegions.size()) > mMaxRegions)
+        markAll();
+}
+
+void DirtyRegions::markAll()
+{
+    mFullyDirty = true;
+    
+    mRegions.clear();
+    mRegions.push_back(mBounds);
+}
+
+bool DirtyRegions::isDirty()
+{
+    return mFullyDirty || !mRegions.empty();
+}
+
+bool DirtyRegions::isFullyDirty()
+{
+    return mFullyDirty;
+}
+
+const std::vector<SDL_Rect>& DirtyRegions::getRegions()
+{
+    return mRegions;
+}
+
+void DirtyRegions::clear()
+{
+    mLastRegionCount = static_cast<int>(mRegions.size());
+    
+    mRegions.clear();
+    mFullyDirty = false;
+}
+
+int DirtyRegions::getLastRegionCount()
+{
+    return mLastRegionCount;
+}
@@ -0,0 +1,58 @@
+//
+//  dirtyRegions.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef dirtyRegions_hpp
+#define dirtyRegions_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+// Collects the parts of the screen that changed this frame, overlapping rectangles are merged as they are marked
+class DirtyRegions
+{
+public:
+    // Initializes an empty set, more than maxRegions separate rectangles turns into one full screen redraw
+    DirtyRegions(int maxRegions = 16);
+    
+    // Sets the screen size rectangles are clipped to and marks the whole screen, since nothing drawn before is valid
+    void setBounds(int width, int height);
+    
+    // Marks a rectangle of the screen as changed
+    void mark(const SDL_Rect &rect);
+    
+    // Marks the whole screen as changed
+    void markAll();
+    
+    // Returns true if anything was marked since the last clear
+    bool isDirty();
+    
+    // Returns true if the whole screen has to be redrawn
+    bool isFullyDirty();
+    
+    // Returns the marked rectangles, a single screen sized one when fully dirty
+    const std::vector<SDL_Rect>& getRegions();
+    
+    // Forgets every marked rectangle, called once the frame has been redrawn
+    void clear();
+    
+    // Returns the number of rectangles redrawn before the last clear
+    int getLastRegionCount();
+
+private:
+    std::vector<SDL_Rect> mRegions;
+    
+    SDL_Rect mBounds;
+    
+    int mMaxRegions;
+    bool mFullyDirty;
+    
+    int mLastRegionCount;
+};
+
+#endif /* dirtyRegions_hpp */
@@ -0,0 +1,155 @@
+//
+//  entityRegistry.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "entityRegistry.hpp"
+
+size_t EntityRegistry::mNextComponentTypeId = 0;
+
+EntityRegistry::EntityRegistry() : mAliveCount(0), mIterationDepth(0)
+{
+    
+}
+
+Entity EntityRegistry::create()
+{
+    Uint32 index;
+    
+    // Reuse the most recently freed slot, its generation was already bumped when it was freed
+    if (!mFreeIndices.empty())
+    {
+        index = mFreeIndices.back();
+        mFreeIndices.pop_back();
+    }
+    else
+    {
+        index = static_cast<Uint32>(mGenerations.size());
+        
+        mGenerations.push_back(0);
+        mAlive.push_back(false);
+    }
+    
+    mAlive[index] = true;
+    mAliveCount++;
+    
+    return {index, mGenerations[index]};
+}
+
+void EntityRegistry::destroy(Entity entity)
+{
+    if (!isAlive(entity))
+        return;
+    
+    if (mIterationDepth > 0)
+    {
+        mPendingDestroys.push_back(entity);
+        
+        return;
+    }
+    
+    for (std::unique_ptr<ComponentPoolBase> &pool : mPools)
+    {
+        if (pool)
+            pool->remove(entity);
+    }
+    
+    // Invalidate every outstanding handle to the slot
+    mGenerations[entity.index]++;
+    mAlive[entity.index] = false;
+    mFreeIndices.push_back(entity.index);
+    mAliveCount--;
+}
+
+bool EntityRegistry::isAlive(Entity entity)
+{
+    return entity.index < mGenerations.size() && mAlive[entity.index] && mGenerations[entity.index] == entity.generation;
+}
+
+size_t EntityRegistry::getAliveCount()
+{
+    return mAliveCount;
+}
+
+void EntityRegistry::getAliveEntities(std::vector<Entity> &entities)
+{
+    entities.clear();
+    entities.reserve(mAliveCount);
+    
+    for (Uint32 index = 0; index < mGenerations.size(); index++)
+    {
+        if (mAlive[index])
+            entities.push_back({index, mGenerations[index]});
+    }
+}
+
+void EntityRegistry::restoreEntities(const std::vector<Entity> &entities)
+{
+    for (std::unique_ptr<ComponentPoolBase> &pool : mPools)
+    {
+        if (pool)
+            pool->clear();
+    }
+    
+    mPendingDestroys.clear();
+    mPendingRemovals.clear();
+    
+    Uint32 slotCount = 0;
+    
+    for (Entity entity : entities)
+    {
+        if (entity.index != NULL_ENTITY.index)
+            slotCount = std::max(slotCount, entity.index + 1);
+    }
+    
+    mGenerations.assign(slotCount, 0);
+    mAlive.assign(slotCount, false);
+    mFreeIndices.clear();
+    mAliveCount = 0;
+    
+    for (Entity entity : entities)
+    {
+        if (entity.index == NULL_ENTITY.index || mAlive[entity.index])
+            continue;
+        
+        mGenerations[entity.index] = entity.generation;
+        mAlive[entity.index] = true;
+        mAliveCount++;
+    }
+    
+    // Pushed highest first, so create() hands the lowest free slot out first
+    for (Uint32 index = slotCount; index-- > 0;)
+    {
+        if (!mAlive[index])
+            mFreeIndices.push_back(index);
+    }
+}
+
+void EntityRegistry::flushDeferred()
+{
+    if (mIterationDepth > 0)
+        return;
+    
+    // Emplaces first, so an entity created and destroyed in the same update ends up fully removed
+    for (std::unique_ptr<ComponentPoolBase> &pool : mPools)
+    {
+        if (pool)
+            pool->applyPendingEmplaces(*this);
+    }
+    
+    for (std::pair<Entity, size_t> &removal : mPendingRemovals)
+    {
+        if (removal.second < mPools.size() && mPools[removal.second])
+            mPools[removal.second]->remove(removal.first);
+    }
+    
+    mPendingRemovals.clear();
+    
+    for (Entity entity : mPendingDestroys)
+        destroy(entity);
+    
+    mPendingDestroys.clear();
+}
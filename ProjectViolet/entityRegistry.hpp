@@ -0,0 +1,383 @@
+//
+//  entityRegistry.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef entityRegistry_hpp
+#define entityRegistry_hpp
+
+#include <algorithm>
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// A handle to an entity, the generation makes handles to destroyed entities stop matching once the slot is reused
+struct Entity
+{
+    Uint32 index;
+    Uint32 generation;
+    
+    bool operator==(const Entity &other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    
+    bool operator!=(const Entity &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// Never refers to a live entity
+const Entity NULL_ENTITY = {0xFFFFFFFF, 0};
+
+class EntityRegistry;
+
+// Type-erased part of a component pool, so the registry can remove components without knowing their types
+class ComponentPoolBase
+{
+public:
+    virtual ~ComponentPoolBase() = default;
+    
+    // Removes the entity's component if it has one
+    virtual void remove(Entity entity) = 0;
+    
+    // Applies the emplaces queued while the registry was being iterated, skipping entities that have died since
+    virtual void applyPendingEmplaces(EntityRegistry &registry) = 0;
+    
+    // Returns the number of components in the pool
+    virtual size_t size() = 0;
+    
+    // Removes every component, including queued emplaces
+    virtual void clear() = 0;
+};
+
+// A sparse set: components sit densely packed in their own array, with a sparse index from entity to slot
+template <typename Component>
+class ComponentPool : public ComponentPoolBase
+{
+public:
+    static constexpr Uint32 INVALID_SLOT = 0xFFFFFFFF;
+    
+    // Returns whether the entity has this component
+    bool contains(Entity entity)
+    {
+        return entity.index < mSparse.size() && mSparse[entity.index] != INVALID_SLOT && mEntities[mSparse[entity.index]] == entity;
+    }
+    
+    // Adds or replaces the entity's component
+    Component& emplace(Entity entity, const Component &component)
+    {
+        if (contains(entity))
+        {
+            markChanged(entity);
+            
+            return mComponents[mSparse[entity.index]] = component;
+        }
+        
+        if (entity.index >= mSparse.size())
+            mSparse.resize(entity.index + 1, INVALID_SLOT);
+        
+        mSparse[entity.index] = static_cast<Uint32>(mEntities.size());
+        mEntities.push_back(entity);
+        mComponents.push_back(component);
+        
+        if (mTrackAdditions)
+            mAdded.push_back(entity);
+        
+        return mComponents.back();
+    }
+    
+    // Queues an emplace for when it is safe to change the dense arrays
+    void queueEmplace(Entity entity, const Component &component)
+    {
+        mPendingEmplaces.emplace_back(entity, component);
+    }
+    
+    void remove(Entity entity) override
+    {
+        if (!contains(entity))
+            return;
+        
+        // Swap the last component into the hole so the array stays dense
+        Uint32 slot = mSparse[entity.index];
+        Uint32 lastSlot = static_cast<Uint32>(mEntities.size() - 1);
+        
+        if (slot != lastSlot)
+        {
+            mEntities[slot] = mEntities[lastSlot];
+            mComponents[slot] = std::move(mComponents[lastSlot]);
+            mSparse[mEntities[slot].index] = slot;
+        }
+        
+        mEntities.pop_back();
+        mComponents.pop_back();
+        mSparse[entity.index] = INVALID_SLOT;
+        
+        markChanged(entity);
+    }
+    
+    // Defined after EntityRegistry, which it asks whether each entity is still alive
+    void applyPendingEmplaces(EntityRegistry &registry) override;
+    
+    size_t size() override
+    {
+        return mEntities.size();
+    }
+    
+    void clear() override
+    {
+        mSparse.clear();
+        mEntities.clear();
+        mComponents.clear();
+        mPendingEmplaces.clear();
+        mAdded.clear();
+        mChanged.clear();
+    }
+    
+    // Returns the entity's component, which it must have
+    Component& get(Entity entity)
+    {
+        return mComponents[mSparse[entity.index]];
+    }
+    
+    // Returns the entity's component, or nullptr if it doesn't have one
+    Component* find(Entity entity)
+    {
+        return contains(entity) ? &mComponents[mSparse[entity.index]] : nullptr;
+    }
+    
+    // Dense arrays, the entity at a slot owns the component at the same slot
+    std::vector<Entity>& entities()
+    {
+        return mEntities;
+    }
+    
+    std::vector<Component>& components()
+    {
+        return mComponents;
+    }
+    
+    // Starts recording the entities that newly gain this component, for systems that react to additions
+    void trackAdditions()
+    {
+        mTrackAdditions = true;
+    }
+    
+    bool isTrackingAdditions()
+    {
+        return mTrackAdditions;
+    }
+    
+    // Entities given this component since the last clearAdded(), some may have lost it or died since
+    std::vector<Entity>& added()
+    {
+        return mAdded;
+    }
+    
+    void clearAdded()
+    {
+        mAdded.clear();
+    }
+    
+    // Starts recording the entities whose component is replaced, removed or marked changed, for systems that
+    // cache something derived from it
+    void trackChanges()
+    {
+        mTrackChanges = true;
+    }
+    
+    bool isTrackingChanges()
+    {
+        return mTrackChanges;
+    }
+    
+    // Records that the entity's component was modified in place, main thread only
+    void markChanged(Entity entity)
+    {
+        if (mTrackChanges)
+            mChanged.push_back(entity);
+    }
+    
+    // Entities whose component changed since the last clearChanged(), may hold repeats and entities that died since
+    std::vector<Entity>& changed()
+    {
+        return mChanged;
+    }
+    
+    void clearChanged()
+    {
+        mChanged.clear();
+    }
+
+private:
+    std::vector<Uint32> mSparse;
+    std::vector<Entity> mEntities;
+    std::vector<Component> mComponents;
+    
+    std::vector<std::pair<Entity, Component>> mPendingEmplaces;
+    
+    std::vector<Entity> mAdded;
+    bool mTrackAdditions = false;
+    
+    std::vector<Entity> mChanged;
+    bool mTrackChanges = false;
+};
+
+// Owns every entity and component pool, structural changes made while iterating are deferred until flushDeferred()
+class EntityRegistry
+{
+public:
+    // Initializes an empty registry
+    EntityRegistry();
+    
+    // Creates a new entity, reusing a destroyed entity's slot when possible
+    Entity create();
+    
+    // Destroys an entity and all of its components, deferred while a view is being iterated
+    void destroy(Entity entity);
+    
+    // Returns whether the handle still refers to a live entity
+    bool isAlive(Entity entity);
+    
+    // Returns the number of live entities
+    size_t getAliveCount();
+    
+    // Fills entities with every live entity in slot order, reusing its storage
+    void getAliveEntities(std::vector<Entity> &entities);
+    
+    // Replaces every entity with the given ones, keeping their slots and generations so saved handles stay valid,
+    // every component is removed and the slots in between are left free, must not be called while iterating
+    void restoreEntities(const std::vector<Entity> &entities);
+    
+    // Applies every structural change that was deferred during iteration
+    void flushDeferred();
+    
+    // Adds or replaces a component, deferred while a view is being iterated
+    template <typename Component>
+    void emplace(Entity entity, const Component &component)
+    {
+        // A stale handle would give a dead slot a component nothing ever removes
+        if (!isAlive(entity))
+            return;
+        
+        if (mIterationDepth > 0)
+            pool<Component>().queueEmplace(entity, component);
+        else
+            pool<Component>().emplace(entity, component);
+    }
+    
+    // Removes a component, deferred while a view is being iterated
+    template <typename Component>
+    void remove(Entity entity)
+    {
+        if (mIterationDepth > 0)
+            mPendingRemovals.emplace_back(entity, componentTypeId<Component>());
+        else
+            pool<Component>().remove(entity);
+    }
+    
+    // Records that the entity's component was modified in place, for the systems tracking that pool's changes
+    template <typename Component>
+    void markChanged(Entity entity)
+    {
+        if (isAlive(entity))
+            pool<Component>().markChanged(entity);
+    }
+    
+    // Returns the entity's component, or nullptr if it doesn't have one
+    template <typename Component>
+    Component* find(Entity entity)
+    {
+        return isAlive(entity) ? pool<Component>().find(entity) : nullptr;
+    }
+    
+    // Returns the pool holding every component of a type
+    template <typename Component>
+    ComponentPool<Component>& pool()
+    {
+        size_t typeId = componentTypeId<Component>();
+        
+        if (typeId >= mPools.size())
+            mPools.resize(typeId + 1);
+        
+        if (!mPools[typeId])
+            mPools[typeId].reset(new ComponentPool<Component>());
+        
+        return *static_cast<ComponentPool<Component>*>(mPools[typeId].get());
+    }
+    
+    // Calls function(entity, components...) for every entity with all of the listed components, walking the
+    // first listed pool's dense arrays in order, so list the rarest component first
+    template <typename First, typename... Rest, typename Function>
+    void each(Function function)
+    {
+        ComponentPool<First> &firstPool = pool<First>();
+        
+        std::vector<Entity> &entities = firstPool.entities();
+        std::vector<First> &components = firstPool.components();
+        
+        // Look the other pools up once rather than per entity
+        std::tuple<ComponentPool<Rest>*...> otherPools(&pool<Rest>()...);
+        
+        mIterationDepth++;
+        
+        for (size_t slot = 0; slot < entities.size(); slot++)
+        {
+            Entity entity = entities[slot];
+            
+            if ((std::get<ComponentPool<Rest>*>(otherPools)->contains(entity) && ...))
+                function(entity, components[slot], std::get<ComponentPool<Rest>*>(otherPools)->get(entity)...);
+        }
+        
+        mIterationDepth--;
+    }
+
+private:
+    // Every component type gets a small index the first time it is used
+    template <typename Component>
+    static size_t componentTypeId()
+    {
+        static const size_t typeId = mNextComponentTypeId++;
+        
+        return typeId;
+    }
+    
+    static size_t mNextComponentTypeId;
+    
+    std::vector<std::unique_ptr<ComponentPoolBase>> mPools;
+    
+    // Slot generations, bumped whenever the slot's entity is destroyed
+    std::vector<Uint32> mGenerations;
+    std::vector<bool> mAlive;
+    std::vector<Uint32> mFreeIndices;
+    
+    size_t mAliveCount;
+    
+    // Non-zero while a view is being iterated
+    int mIterationDepth;
+    
+    std::vector<Entity> mPendingDestroys;
+    std::vector<std::pair<Entity, size_t>> mPendingRemovals;
+};
+
+template <typename Component>
+void ComponentPool<Component>::applyPendingEmplaces(EntityRegistry &registry)
+{
+    // The entity may have been destroyed after its emplace was queued
+    for (std::pair<Entity, Component> &pending : mPendingEmplaces)
+    {
+        if (registry.isAlive(pending.first))
+            emplace(pending.first, pending.second);
+    }
+    
+    mPendingEmplaces.clear();
+}
+
+#endif /* entityRegistry_hpp */
@@ -0,0 +1,96 @@
+//
+//  frameArena.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "frameArena.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+
+LinearArena::LinearArena(size_t capacity) : mBlock(new Uint8[capacity]), mCapacity(capacity), mOffset(0), mOverflowBytes(0), mPeakUsage(0), mOverflowCount(0)
+{
+    
+}
+
+void* LinearArena::allocate(size_t size, size_t alignment)
+{
+    // Round the offset up to the alignment, which is always a power of two
+    size_t alignedOffset = (mOffset + alignment - 1) & ~(alignment - 1);
+    
+    if (alignedOffset + size <= mCapacity)
+    {
+        mOffset = alignedOffset + size;
+        
+        return mBlock.get() + alignedOffset;
+    }
+    
+    // Too big for what's left, give it its own block and remember to grow at the next reset
+    mOverflowCount++;
+    mOverflowBytes += size + alignment;
+    
+    mOverflowBlocks.emplace_back(new Uint8[size + alignment]);
+    
+    Uint8 *block = mOverflowBlocks.back().get();
+    
+    return block + ((alignment - reinterpret_cast<uintptr_t>(block) % alignment) % alignment);
+}
+
+void LinearArena::reset()
+{
+    mPeakUsage = std::max(mPeakUsage, getUsed());
+    
+    // One bigger block now, rather than spilling every frame
+    if (!mOverflowBlocks.empty())
+    {
+        mCapacity = std::max(mCapacity * 2, mOffset + mOverflowBytes);
+        mBlock.reset(new Uint8[mCapacity]);
+        
+        mOverflowBlocks.clear();
+    }
+    
+    mOffset = 0;
+    mOverflowBytes = 0;
+}
+
+size_t LinearArena::getUsed()
+{
+    return mOffset + mOverflowBytes;
+}
+
+size_t LinearArena::getPeakUsage()
+{
+    return std::max(mPeakUsage, getUsed());
+}
+
+size_t LinearArena::getCapacity()
+{
+    return mCapacity;
+}
+
+int LinearArena::getOverflowCount()
+{
+    return mOverflowCount;
+}
+
+namespace FrameMemory
+{
+    LinearArena& getArena()
+    {
+        static LinearArena frameArena(DEFAULT_FRAME_ARENA_SIZE);
+        
+        return frameArena;
+    }
+    
+    void beginFrame()
+    {
+        LinearArena &arena = getArena();
+        
+        PROFILE_COUNTER("Frame arena bytes", arena.getUsed())
+        
+        arena.reset();
+    }
+}
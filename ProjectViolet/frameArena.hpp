@@ -0,0 +1,122 @@
+//
+//  frameArena.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef frameArena_hpp
+#define frameArena_hpp
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+// Hands out memory by bumping an offset through one block, everything is released at once by reset()
+class LinearArena
+{
+public:
+    // Initializes the arena with a block of the given size
+    LinearArena(size_t capacity);
+    
+    // Returns memory for size bytes, never nullptr, allocations that don't fit spill into extra blocks until the next reset
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    
+    // Returns uninitialized storage for count values, only for types that don't need destroying
+    template <typename Value>
+    Value* allocateArray(size_t count)
+    {
+        return static_cast<Value*>(allocate(count * sizeof(Value), alignof(Value)));
+    }
+    
+    // Releases everything allocated, growing the block if the last cycle spilled so the next one won't
+    void reset();
+    
+    // Bytes allocated since the last reset
+    size_t getUsed();
+    
+    // Most bytes allocated between two resets
+    size_t getPeakUsage();
+    
+    size_t getCapacity();
+    
+    // Returns how many allocations didn't fit in the block since the arena was created
+    int getOverflowCount();
+
+private:
+    std::unique_ptr<Uint8[]> mBlock;
+    size_t mCapacity, mOffset;
+    
+    // Allocations that didn't fit, freed on reset
+    std::vector<std::unique_ptr<Uint8[]>> mOverflowBlocks;
+    size_t mOverflowBytes;
+    
+    size_t mPeakUsage;
+    int mOverflowCount;
+};
+
+// Standard allocator over an arena, so containers can hold per-frame scratch data, deallocation does nothing
+template <typename Value>
+class ArenaAllocator
+{
+public:
+    using value_type = Value;
+    
+    ArenaAllocator(LinearArena &arena) : mArena(&arena)
+    {
+        
+    }
+    
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other> &other) : mArena(other.mArena)
+    {
+        
+    }
+    
+    Value* allocate(size_t count)
+    {
+        return mArena->allocateArray<Value>(count);
+    }
+    
+    void deallocate(Value*, size_t)
+    {
+        
+    }
+    
+    template <typename Other>
+    bool operator==(const ArenaAllocator<Other> &other) const
+    {
+        return mArena == other.mArena;
+    }
+    
+    template <typename Other>
+    bool operator!=(const ArenaAllocator<Other> &other) const
+    {
+        return mArena != other.mArena;
+    }
+
+private:
+    template <typename Other>
+    friend class ArenaAllocator;
+    
+    LinearArena *mArena;
+};
+
+// The main thread's frame arena, for scratch data that only lives until the end of the frame
+namespace FrameMemory
+{
+    // Size of the frame arena's block before it has had to grow
+    const size_t DEFAULT_FRAME_ARENA_SIZE = 1 << 20;
+    
+    // Returns the frame arena, main thread only
+    LinearArena& getArena();
+    
+    // Releases the previous frame's scratch data, called at the top of every main loop iteration
+    void beginFrame();
+}
+
+#endif /* frameArena_hpp */
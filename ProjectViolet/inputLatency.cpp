@@ -0,0 +1,136 @@
+//
+//  inputLatency.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "inputLatency.hpp"
+#include "profiler.hpp"
+
+namespace
+{
+    std::array<int, InputLatency::BUCKET_COUNT> mHistogram = {};
+    
+    int mSampleCount = 0;
+    Uint64 mTotalLatency = 0;
+    Uint32 mMaximumLatency = 0;
+    
+    // Timestamp of the oldest input not presented yet
+    bool mInputPending = false;
+    Uint32 mOldestInput = 0;
+    
+    // Returns the latency below which the fraction of samples lies
+    double findPercentile(double fraction)
+    {
+        int target = static_cast<int>(fraction * (mSampleCount - 1));
+        int seen = 0;
+        
+        for (int i = 0; i < InputLatency::BUCKET_COUNT; i++)
+        {
+            seen += mHistogram[i];
+            
+            if (seen > target)
+                return i;
+        }
+        
+        return InputLatency::BUCKET_COUNT - 1;
+    }
+}
+
+namespace InputLatency
+{
+    bool isInputEvent(const SDL_Event &event)
+    {
+        // Keyboard, text, mouse, joystick, controller, touch and gesture events sit between these two in SDL_EventType
+        return event.type >= SDL_KEYDOWN && event.type < SDL_CLIPBOARDUPDATE;
+    }
+    
+    void recordInput(Uint32 timestamp)
+    {
+        // Timestamps are unsigned ticks, compare their difference so the wrap after 49 days doesn't matter
+        if (!mInputPending || static_cast<Sint32>(timestamp - mOldestInput) < 0)
+            mOldestInput = timestamp;
+        
+        mInputPending = true;
+    }
+    
+    void recordPresent()
+    {
+        if (!mInputPending)
+            return;
+        
+        mInputPending = false;
+        
+        Uint32 latency = SDL_GetTicks() - mOldestInput;
+        
+        mHistogram[latency < static_cast<Uint32>(BUCKET_COUNT) ? latency : BUCKET_COUNT - 1]++;
+        
+        mSampleCount++;
+        mTotalLatency += latency;
+        
+        if (latency > mMaximumLatency)
+            mMaximumLatency = latency;
+        
+        PROFILE_COUNTER("Input latency (ms)", latency)
+    }
+    
+    void dropPendingInput()
+    {
+        mInputPending = false;
+    }
+    
+    const std::array<int, BUCKET_COUNT>& getHistogram()
+    {
+        return mHistogram;
+    }
+    
+    int getSampleCount()
+    {
+        return mSampleCount;
+    }
+    
+    Benchmark::TimingStatistics getStatistics()
+    {
+        Benchmark::TimingStatistics statistics = {mSampleCount, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        
+        if (mSampleCount == 0)
+            return statistics;
+        
+        statistics.mean = static_cast<double>(mTotalLatency) / mSampleCount;
+        statistics.minimum = findPercentile(0.0);
+        statistics.p50 = findPercentile(0.5);
+        statistics.p90 = findPercentile(0.9);
+        statistics.p99 = findPercentile(0.99);
+        statistics.maximum = mMaximumLatency;
+        
+        return statistics;
+    }
+    
+    void writeHistogram(std::ostream &output, std::string name)
+    {
+        // Trailing empty buckets are left off to keep the line short
+        int lastBucket = BUCKET_COUNT - 1;
+        
+        while (lastBucket > 0 && mHistogram[lastBucket] == 0)
+            lastBucket--;
+        
+        output << "{\"histogram\":\"" << name << "\",\"bucket_ms\":1,\"samples\":" << mSampleCount << ",\"counts\":[";
+        
+        for (int i = 0; i <= lastBucket; i++)
+            output << (i > 0 ? "," : "") << mHistogram[i];
+        
+        output << "]}\n";
+    }
+    
+    void reset()
+    {
+        mHistogram.fill(0);
+        
+        mSampleCount = 0;
+        mTotalLatency = 0;
+        mMaximumLatency = 0;
+        mInputPending = false;
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  inputLatency.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef inputLatency_hpp
+#define inputLatency_hpp
+
+#include <array>
+#include <ostream>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+
+#include "benchmark.hpp"
+
+// Measures how old the input shown by each presented frame is, from the event's timestamp until SDL_RenderPresent returns,
+// main thread only
+namespace InputLatency
+{
+    // Buckets are a millisecond wide, the resolution of SDL's event timestamps, the last one holds everything slower
+    const int BUCKET_COUNT = 101;
+    
+    // Returns true for keyboard, mouse, controller and touch events, the ones a player waits on
+    bool isInputEvent(const SDL_Event &event);
+    
+    // Notes an input event handled this frame, only the oldest one per frame is measured
+    void recordInput(Uint32 timestamp);
+    
+    // Measures the oldest input handled since the last present, called once SDL_RenderPresent has returned
+    void recordPresent();
+    
+    // Forgets the input handled since the last present, called for frames that present nothing
+    void dropPendingInput();
+    
+    // Returns how many presented frames fell into each millisecond of latency
+    const std::array<int, BUCKET_COUNT>& getHistogram();
+    
+    // Returns the number of presented frames that showed new input
+    int getSampleCount();
+    
+    // Summarizes the histogram, percentiles are as precise as the buckets
+    Benchmark::TimingStatistics getStatistics();
+    
+    // Writes the histogram as a single line of JSON, next to the benchmark results it is compared with
+    void writeHistogram(std::ostream &output, std::string name);
+    
+    // Forgets every measurement
+    void reset();
+}
+
+#endif /* inputLatency_hpp */
@@ -0,0 +1,396 @@
+//
+//  inputRecorder.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "inputRecorder.hpp"
+#include "profiler.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+InputRecorder::InputRecorder() : mRecording(false), mRecordBufferUsed(0), mFrameStarted(false), mFrameTime(0.0), mPassFirstEvent(0), mRecordedFrameCount(0), mRecordedUpdateInterval(0.0), mReplayUpdateInterval(0.0), mReplayFrame(0), mReplayPass(0), mReplayEventIndex(0), mReplaying(false), mReplayPassesSkipped(false)
+{
+    
+}
+
+InputRecorder::~InputRecorder()
+{
+    stopRecording();
+}
+
+bool InputRecorder::startRecording(std::string filePath, double updateInterval)
+{
+    stopRecording();
+    
+    // Recorded next to the real file and renamed over it once complete, so an interrupted run never replaces a good recording
+    mRecordingPath = filePath;
+    mRecordingFile.open(filePath + ".tmp", std::ios::binary | std::ios::trunc);
+    
+    // The frame count is filled in when recording stops
+    RecordingHeader header = {RECORDING_MAGIC, RECORDING_VERSION, sizeof(SDL_Event), 0, updateInterval};
+    
+    mRecordingFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    if (!mRecordingFile)
+    {
+        LOG_MESSAGE(Error, "Failed to create the input recording %s!", filePath.c_str())
+        
+        mRecordingFile.close();
+        
+        return false;
+    }
+    
+    mRecordBuffer.resize(RECORD_BUFFER_SIZE);
+    mRecordBufferUsed = 0;
+    
+    mFrameEvents.clear();
+    mFrameEvents.reserve(64);
+    mPassEventCounts.clear();
+    mPassFirstEvent = 0;
+    mFrameStarted = false;
+    
+    mRecordedFrameCount = 0;
+    mRecordedUpdateInterval = updateInterval;
+    mRecording = true;
+    
+    return true;
+}
+
+bool InputRecorder::stopRecording()
+{
+    if (!mRecording)
+        return true;
+    
+    mRecording = false;
+    
+    bool success = true;
+    
+    if (mFrameStarted && !endRecordedFrame())
+        success = false;
+    
+    mFrameStarted = false;
+    
+    if (!flushRecordBuffer())
+        success = false;
+    
+    // Now that every frame is written the header can say how many there are
+    RecordingHeader header = {RECORDING_MAGIC, RECORDING_VERSION, sizeof(SDL_Event), mRecordedFrameCount, mRecordedUpdateInterval};
+    
+    mRecordingFile.seekp(0);
+    mRecordingFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    mRecordingFile.close();
+    
+    if (!success || !mRecordingFile)
+    {
+        LOG_MESSAGE(Error, "Failed to write the input recording %s!", mRecordingPath.c_str())
+        
+        return false;
+    }
+    
+    std::string temporaryPath = mRecordingPath + ".tmp";
+    
+    if (std::rename(temporaryPath.c_str(), mRecordingPath.c_str()) != 0)
+    {
+        LOG_MESSAGE(Error, "Failed to replace the input recording %s!", mRecordingPath.c_str())
+        
+        return false;
+    }
+    
+    LOG_MESSAGE(Information, "Recorded %u frames of input to %s", mRecordedFrameCount, mRecordingPath.c_str())
+    
+    return true;
+}
+
+bool InputRecorder::loadReplay(std::string filePath)
+{
+    PROFILE_ZONE("InputRecorder::loadReplay")
+    
+    std::ifstream file(filePath, std::ios::binary);
+    
+    RecordingHeader header;
+    
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != RECORDING_MAGIC)
+    {
+        LOG_MESSAGE(Error, "%s is not an input recording!", filePath.c_str())
+        
+        return false;
+    }
+    
+    if (header.version != RECORDING_VERSION)
+    {
+        LOG_MESSAGE(Error, "%s is a version %u input recording, only version %u can be replayed!", filePath.c_str(), header.version, RECORDING_VERSION)
+        
+        return false;
+    }
+    
+    if (header.eventSize != sizeof(SDL_Event))
+    {
+        LOG_MESSAGE(Error, "%s was recorded by a build with a different SDL_Event layout!", filePath.c_str())
+        
+        return false;
+    }
+    
+    mReplayFrames.clear();
+    mReplayPasses.clear();
+    mReplayEvents.clear();
+    mReplayFrames.reserve(header.frameCount);
+    
+    Uint32 passEventCounts[MAX_POLL_PASSES];
+    
+    for (Uint32 i = 0; i < header.frameCount; i++)
+    {
+        ReplayFrame frame = {0.0, static_cast<Uint32>(mReplayPasses.size()), 0};
+        
+        if (!file.read(reinterpret_cast<char*>(&frame.frameTime), sizeof(frame.frameTime)) || !file.read(reinterpret_cast<char*>(&frame.passCount), sizeof(frame.passCount)))
+            break;
+        
+        if (frame.passCount > MAX_POLL_PASSES || !file.read(reinterpret_cast<char*>(passEventCounts), static_cast<std::streamsize>(frame.passCount * sizeof(Uint32))))
+            break;
+        
+        // Each pass's events follow the counts, one pass after another
+        Uint32 firstEvent = static_cast<Uint32>(mReplayEvents.size());
+        Uint32 frameEventCount = 0;
+        
+        for (Uint32 pass = 0; pass < frame.passCount; pass++)
+        {
+            mReplayPasses.push_back({firstEvent + frameEventCount, passEventCounts[pass]});
+            frameEventCount += passEventCounts[pass];
+        }
+        
+        mReplayEvents.resize(mReplayEvents.size() + frameEventCount);
+        
+        if (!file.read(reinterpret_cast<char*>(mReplayEvents.data() + firstEvent), static_cast<std::streamsize>(frameEventCount * sizeof(SDL_Event))))
+            break;
+        
+        mReplayFrames.push_back(frame);
+    }
+    
+    if (mReplayFrames.size() != header.frameCount)
+    {
+        LOG_MESSAGE(Error, "The input recording %s is damaged!", filePath.c_str())
+        
+        mReplayFrames.clear();
+        mReplayPasses.clear();
+        mReplayEvents.clear();
+        
+        return false;
+    }
+    
+    mReplayUpdateInterval = header.updateInterval;
+    mReplayFrame = 0;
+    mReplayPass = 0;
+    mReplayEventIndex = 0;
+    mReplayPassesSkipped = false;
+    mReplaying = true;
+    
+    return true;
+}
+
+bool InputRecorder::isRecording()
+{
+    return mRecording;
+}
+
+bool InputRecorder::isReplaying()
+{
+    return mReplaying;
+}
+
+bool InputRecorder::isReplayFinished()
+{
+    return mReplaying && mReplayFrame >= mReplayFrames.size();
+}
+
+int InputRecorder::getReplayFrameCount()
+{
+    return static_cast<int>(mReplayFrames.size());
+}
+
+double InputRecorder::getReplayUpdateInterval()
+{
+    return mReplayUpdateInterval;
+}
+
+void InputRecorder::beginFrame(double &frameTime)
+{
+    if (mRecording)
+    {
+        if (mFrameStarted)
+            endRecordedFrame();
+        
+        mFrameStarted = true;
+        mFrameTime = frameTime;
+        mFrameEvents.clear();
+        mPassEventCounts.clear();
+        mPassFirstEvent = 0;
+    }
+    
+    if (mReplaying)
+    {
+        // A replay that polls fewer times per frame than the recording did never sees the later passes' events
+        if (mReplayFrame > 0 && mReplayFrame <= mReplayFrames.size() && !mReplayPassesSkipped)
+        {
+            const ReplayFrame &previousFrame = mReplayFrames[mReplayFrame - 1];
+            
+            for (Uint32 pass = mReplayPass; pass < previousFrame.passCount; pass++)
+            {
+                if (mReplayPasses[previousFrame.firstPass + pass].eventCount > 0)
+                {
+                    LOG_MESSAGE(Warning, "The recording polled for input more often per frame than this replay, some of its input was skipped!")
+                    
+                    mReplayPassesSkipped = true;
+                    
+                    break;
+                }
+            }
+        }
+        
+        // Frames past the end of the recording keep their real time and get no input
+        if (mReplayFrame < mReplayFrames.size())
+            frameTime = mReplayFrames[mReplayFrame].frameTime;
+        
+        mReplayFrame++;
+        mReplayPass = 0;
+        mReplayEventIndex = 0;
+    }
+}
+
+bool InputRecorder::pollEvent(SDL_Event &event)
+{
+    if (!mReplaying)
+    {
+        if (!SDL_PollEvent(&event))
+        {
+            if (mRecording && mFrameStarted)
+                endRecordedPass();
+            
+            return false;
+        }
+        
+        if (mRecording && mFrameStarted && isRecordable(event))
+            mFrameEvents.push_back(event);
+        
+        return true;
+    }
+    
+    // Real input is thrown away, but quitting and losing the render device still have to be handled
+    while (SDL_PollEvent(&event))
+    {
+        if (event.type == SDL_QUIT || event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+            return true;
+    }
+    
+    if (mReplayFrame == 0 || mReplayFrame > mReplayFrames.size())
+        return false;
+    
+    const ReplayFrame &frame = mReplayFrames[mReplayFrame - 1];
+    
+    // Passes beyond the ones recorded get nothing
+    if (mReplayPass >= frame.passCount)
+        return false;
+    
+    const ReplayPass &pass = mReplayPasses[frame.firstPass + mReplayPass];
+    
+    if (mReplayEventIndex >= pass.eventCount)
+    {
+        mReplayPass++;
+        mReplayEventIndex = 0;
+        
+        return false;
+    }
+    
+    event = mReplayEvents[pass.firstEvent + mReplayEventIndex++];
+    
+    // Restamped as it's delivered, latency measured during a replay starts when the event would have been polled
+    event.common.timestamp = SDL_GetTicks();
+    
+    return true;
+}
+
+bool InputRecorder::isRecordable(const SDL_Event &event)
+{
+    // Window manager messages, drops and user events point at memory that won't exist on replay
+    if (event.type == SDL_SYSWMEVENT || (event.type >= SDL_DROPFILE && event.type <= SDL_DROPCOMPLETE) || event.type >= SDL_USEREVENT)
+        return false;
+    
+    // Device resets come from the machine rather than the player, a replay handles its own
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+        return false;
+    
+    return true;
+}
+
+void InputRecorder::endRecordedPass()
+{
+    // Passes past the limit are folded into the last one, a replay still gets their events in the same frame
+    if (mPassEventCounts.size() >= MAX_POLL_PASSES)
+        mPassEventCounts.back() += static_cast<Uint32>(mFrameEvents.size() - mPassFirstEvent);
+    else
+        mPassEventCounts.push_back(static_cast<Uint32>(mFrameEvents.size() - mPassFirstEvent));
+    
+    mPassFirstEvent = mFrameEvents.size();
+}
+
+bool InputRecorder::endRecordedFrame()
+{
+    // Events from a pass that never finished still belong to the frame
+    if (mPassFirstEvent < mFrameEvents.size())
+        endRecordedPass();
+    
+    Uint32 passCount = static_cast<Uint32>(mPassEventCounts.size());
+    
+    size_t countBytes = passCount * sizeof(Uint32);
+    size_t eventBytes = mFrameEvents.size() * sizeof(SDL_Event);
+    size_t frameBytes = sizeof(mFrameTime) + sizeof(passCount) + countBytes + eventBytes;
+    
+    mRecordedFrameCount++;
+    
+    if (mRecordBufferUsed + frameBytes > mRecordBuffer.size() && !flushRecordBuffer())
+        return false;
+    
+    // A frame too big for the buffer on its own goes straight to the file
+    if (frameBytes > mRecordBuffer.size())
+    {
+        mRecordingFile.write(reinterpret_cast<const char*>(&mFrameTime), sizeof(mFrameTime));
+        mRecordingFile.write(reinterpret_cast<const char*>(&passCount), sizeof(passCount));
+        mRecordingFile.write(reinterpret_cast<const char*>(mPassEventCounts.data()), static_cast<std::streamsize>(countBytes));
+        mRecordingFile.write(reinterpret_cast<const char*>(mFrameEvents.data()), static_cast<std::streamsize>(eventBytes));
+        
+        return static_cast<bool>(mRecordingFile);
+    }
+    
+    Uint8 *destination = mRecordBuffer.data() + mRecordBufferUsed;
+    
+    std::memcpy(destination, &mFrameTime, sizeof(mFrameTime));
+    destination += sizeof(mFrameTime);
+    
+    std::memcpy(destination, &passCount, sizeof(passCount));
+    destination += sizeof(passCount);
+    
+    if (passCount > 0)
+        std::memcpy(destination, mPassEventCounts.data(), countBytes);
+    
+    destination += countBytes;
+    
+    if (!mFrameEvents.empty())
+        std::memcpy(destination, mFrameEvents.data(), eventBytes);
+    
+    mRecordBufferUsed += frameBytes;
+    
+    return true;
+}
+
+bool InputRecorder::flushRecordBuffer()
+{
+    PROFILE_ZONE("InputRecorder::flushRecordBuffer")
+    
+    mRecordingFile.write(reinterpret_cast<const char*>(mRecordBuffer.data()), static_cast<std::streamsize>(mRecordBufferUsed));
+    mRecordBufferUsed = 0;
+    
+    return static_cast<bool>(mRecordingFile);
+}
@@ -0,0 +1,143 @@
+//
+//  inputRecorder.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef inputRecorder_hpp
+#define inputRecorder_hpp
+
+#include <fstream>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Records every frame's events and frame time to a file, or plays a recording back in place of SDL's event queue,
+// so the same session can be run against every build and its frame times compared
+class InputRecorder
+{
+public:
+    // Initializes a recorder that neither records nor replays
+    InputRecorder();
+    
+    // Finishes the recording in progress
+    ~InputRecorder();
+    
+    // Starts recording to the file, updateInterval is stored so replays step the simulation the same way
+    bool startRecording(std::string filePath, double updateInterval);
+    
+    // Writes out the last frame and completes the file's header, does nothing if not recording
+    bool stopRecording();
+    
+    // Reads a recording to play back in place of real input
+    bool loadReplay(std::string filePath);
+    
+    // Returns true while frames are being recorded
+    bool isRecording();
+    
+    // Returns true if a recording was loaded for playback
+    bool isReplaying();
+    
+    // Returns true once every recorded frame has been played back
+    bool isReplayFinished();
+    
+    // Returns the number of frames in the loaded recording
+    int getReplayFrameCount();
+    
+    // Returns the simulation step the loaded recording was made with, in seconds
+    double getReplayUpdateInterval();
+    
+    // Starts the next frame, when replaying frameTime is replaced by the recorded one so the simulation steps exactly as it did
+    void beginFrame(double &frameTime);
+    
+    // Takes the place of SDL_PollEvent, when replaying the frame's recorded events are returned instead of real ones,
+    // except for quitting and render device resets, which still have to be handled
+    // Each run of calls until it returns false is one pass, a replayed pass only returns the events the same pass got
+    // while recording, so input handled late in a frame stays late in the replay
+    bool pollEvent(SDL_Event &event);
+    
+    static const Uint32 RECORDING_MAGIC = 0x43455256; // "VREC"
+    static const Uint32 RECORDING_VERSION = 2;
+    
+    // More passes than this in one frame means the recording is damaged
+    static const Uint32 MAX_POLL_PASSES = 16;
+    
+    // Encoded frames are collected in a buffer this size and written out whenever the next frame wouldn't fit
+    static const size_t RECORD_BUFFER_SIZE = 64 * 1024;
+
+private:
+    // Events are stored as raw SDL_Events, so a recording only replays on a build with the same SDL and platform
+    struct RecordingHeader
+    {
+        Uint32 magic;
+        Uint32 version;
+        Uint32 eventSize;
+        Uint32 frameCount;
+        double updateInterval;
+    };
+    
+    // A recorded frame, its passes are passCount entries of mReplayPasses starting at firstPass
+    struct ReplayFrame
+    {
+        double frameTime;
+        Uint32 firstPass;
+        Uint32 passCount;
+    };
+    
+    // One poll pass of a recorded frame, its events are eventCount entries of mReplayEvents starting at firstEvent
+    struct ReplayPass
+    {
+        Uint32 firstEvent;
+        Uint32 eventCount;
+    };
+    
+    // Returns false for events holding pointers, which can't be written to a file
+    static bool isRecordable(const SDL_Event &event);
+    
+    // Ends the poll pass being recorded, counting the events it got
+    void endRecordedPass();
+    
+    // Encodes the frame that just ended into the record buffer
+    bool endRecordedFrame();
+    
+    // Writes the record buffer to the file and empties it
+    bool flushRecordBuffer();
+    
+    std::ofstream mRecordingFile;
+    std::string mRecordingPath;
+    bool mRecording;
+    
+    // Encoded frames not written to the file yet, sized once when recording starts
+    std::vector<Uint8> mRecordBuffer;
+    size_t mRecordBufferUsed;
+    
+    // The frame being recorded, written out when the next one begins
+    bool mFrameStarted;
+    double mFrameTime;
+    std::vector<SDL_Event> mFrameEvents;
+    
+    // Events each finished pass of the frame got, mPassFirstEvent is where the pass in progress starts in mFrameEvents
+    std::vector<Uint32> mPassEventCounts;
+    size_t mPassFirstEvent;
+    
+    Uint32 mRecordedFrameCount;
+    double mRecordedUpdateInterval;
+    
+    // The loaded recording, mReplayFrame is the frame being played back and mReplayPass the pass within it
+    std::vector<ReplayFrame> mReplayFrames;
+    std::vector<ReplayPass> mReplayPasses;
+    std::vector<SDL_Event> mReplayEvents;
+    double mReplayUpdateInterval;
+    size_t mReplayFrame;
+    Uint32 mReplayPass;
+    Uint32 mReplayEventIndex;
+    bool mReplaying;
+    
+    // Set once a frame ended with recorded passes never polled for, so the warning is only logged once
+    bool mReplayPassesSkipped;
+};
+
+#endif /* inputRecorder_hpp */
@@ -0,0 +1,231 @@
+//
+//  jobSystem.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "jobSystem.hpp"
+#include "profiler.hpp"
+
+namespace
+{
+    // The system the calling thread works for and its deque, threads that aren't workers use the shared deque
+    thread_local JobSystem *tJobSystem = nullptr;
+    thread_local int tQueueIndex = 0;
+}
+
+JobSystem::JobSystem() : mQueuedJobs(0), mRunning(false)
+{
+    
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+void JobSystem::start(int workerCount)
+{
+    if (mRunning)
+        return;
+    
+    if (workerCount <= 0)
+        workerCount = std::max(1, SDL_GetCPUCount() - 1);
+    
+    // Deque 0 is shared by every thread that isn't a worker
+    mQueues.clear();
+    
+    for (int i = 0; i <= workerCount; i++)
+        mQueues.push_back(std::make_unique<WorkQueue>());
+    
+    mRunning = true;
+    
+    for (int i = 1; i <= workerCount; i++)
+        mWorkers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        
+        mRunning = false;
+        mBackgroundJobs.clear();
+    }
+    
+    mSleepCondition.notify_all();
+    
+    for (std::thread &worker : mWorkers)
+        worker.join();
+    
+    mWorkers.clear();
+    mQueues.clear();
+    mQueuedJobs = 0;
+}
+
+void JobSystem::run(std::function<void()> task, JobCounter *counter)
+{
+    if (mWorkers.empty())
+    {
+        task();
+        
+        return;
+    }
+    
+    push({nullptr, nullptr, 0, 0, counter, std::move(task)});
+}
+
+void JobSystem::runBackground(std::function<void()> task)
+{
+    if (mWorkers.empty())
+    {
+        task();
+        
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        
+        mBackgroundJobs.push_back(std::move(task));
+    }
+    
+    mSleepCondition.notify_one();
+}
+
+void JobSystem::push(Job job)
+{
+    if (job.counter != nullptr)
+        job.counter->mPending.fetch_add(1, std::memory_order_relaxed);
+    
+    WorkQueue &queue = *mQueues[tJobSystem == this ? tQueueIndex : 0];
+    
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        
+        queue.pushBack(job);
+    }
+    
+    mQueuedJobs.fetch_add(1, std::memory_order_release);
+    
+    // Taking the lock orders the push against a worker that is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    
+    mSleepCondition.notify_one();
+}
+
+bool JobSystem::findJob(Job &job)
+{
+    if (mQueuedJobs.load(std::memory_order_acquire) == 0)
+        return false;
+    
+    int ownIndex = tJobSystem == this ? tQueueIndex : 0;
+    
+    // Newest first from our own deque, its data is most likely still in cache
+    {
+        WorkQueue &queue = *mQueues[ownIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        
+        if (queue.popBack(job))
+        {
+            mQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            
+            return true;
+        }
+    }
+    
+    // Then the oldest from everyone else, starting after ourselves so thieves spread out
+    int queueCount = static_cast<int>(mQueues.size());
+    
+    for (int offset = 1; offset < queueCount; offset++)
+    {
+        WorkQueue &queue = *mQueues[(ownIndex + offset) % queueCount];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        
+        if (lock.owns_lock() && queue.popFront(job))
+        {
+            mQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+void JobSystem::execute(Job &job)
+{
+    if (job.invoke != nullptr)
+        job.invoke(job.context, job.begin, job.end);
+    else
+        job.task();
+    
+    if (job.counter != nullptr)
+        job.counter->mPending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+    PROFILE_ZONE("JobSystem::wait")
+    
+    Job job;
+    
+    // Help out instead of blocking, only yielding when there's nothing left to take
+    while (!counter.isDone())
+    {
+        if (findJob(job))
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(int workerIndex)
+{
+    tJobSystem = this;
+    tQueueIndex = workerIndex;
+    
+    Job job;
+    
+    while (true)
+    {
+        if (findJob(job))
+        {
+            execute(job);
+            
+            continue;
+        }
+        
+        std::function<void()> backgroundJob;
+        
+        {
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            
+            mSleepCondition.wait(lock, [this]()
+            {
+                return !mRunning || mQueuedJobs.load(std::memory_order_acquire) > 0 || !mBackgroundJobs.empty();
+            });
+            
+            if (!mRunning)
+                return;
+            
+            // Frame jobs always go first
+            if (mQueuedJobs.load(std::memory_order_acquire) > 0 || mBackgroundJobs.empty())
+                continue;
+            
+            backgroundJob = std::move(mBackgroundJobs.front());
+            mBackgroundJobs.pop_front();
+        }
+        
+        backgroundJob();
+    }
+}
+
+int JobSystem::getWorkerCount()
+{
+    return static_cast<int>(mWorkers.size());
+}
@@ -0,0 +1,193 @@
+//
+//  jobSystem.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef jobSystem_hpp
+#define jobSystem_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <SDL.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+// Counts the unfinished jobs of a group, wait on it to join them
+class JobCounter
+{
+public:
+    JobCounter() : mPending(0)
+    {
+        
+    }
+    
+    // Returns whether every job counted by this has finished
+    bool isDone()
+    {
+        return mPending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+    
+    std::atomic<int> mPending;
+};
+
+// Runs frame work across every core: each worker owns a deque it pushes to and pops from the back of,
+// idle workers steal from the front of the others', and background work (decoding) only runs when no frame work is left
+class JobSystem
+{
+public:
+    // Initializes the system without starting any threads, jobs run inline until started
+    JobSystem();
+    
+    // Stops the workers
+    ~JobSystem();
+    
+    // Starts the workers, 0 uses one less than the number of cores since the main thread helps while it waits
+    void start(int workerCount = 0);
+    
+    // Finishes the jobs that are running, drops the queued ones and joins the workers
+    void stop();
+    
+    // Queues a frame job, the counter (if any) is only done once the job has run
+    void run(std::function<void()> task, JobCounter *counter = nullptr);
+    
+    // Queues a job that may take a while, it never delays frame jobs and is never run by a waiting main thread
+    void runBackground(std::function<void()> task);
+    
+    // Runs queued frame jobs until every job counted by the counter has finished
+    void wait(JobCounter &counter);
+    
+    // Splits [begin, end) into ranges of grainSize and calls function(rangeBegin, rangeEnd) on each in parallel,
+    // returning once all are done, the ranges must be safe to process at the same time
+    template <typename Function>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, Function function)
+    {
+        if (end <= begin)
+            return;
+        
+        grainSize = std::max<size_t>(grainSize, 1);
+        
+        // Not worth waking anyone for a single range
+        if (mWorkers.empty() || end - begin <= grainSize)
+        {
+            function(begin, end);
+            
+            return;
+        }
+        
+        JobCounter counter;
+        
+        for (size_t rangeBegin = begin; rangeBegin < end; rangeBegin += grainSize)
+            push({&invokeRange<Function>, &function, rangeBegin, std::min(rangeBegin + grainSize, end), &counter, nullptr});
+        
+        wait(counter);
+    }
+    
+    // Returns the number of worker threads, not counting the main thread
+    int getWorkerCount();
+
+private:
+    // A range job calls invoke with its context, a task job holds a function instead, neither allocates unless the task does
+    struct Job
+    {
+        void (*invoke)(const void *context, size_t begin, size_t end);
+        const void *context;
+        size_t begin, end;
+        
+        JobCounter *counter;
+        
+        std::function<void()> task;
+    };
+    
+    template <typename Function>
+    static void invokeRange(const void *context, size_t begin, size_t end)
+    {
+        (*static_cast<Function*>(const_cast<void*>(context)))(begin, end);
+    }
+    
+    // A deque per worker plus one for threads that aren't workers (the main thread), kept as a ring
+    // that only grows, so steady state frames queue jobs without allocating
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        
+        std::vector<Job> slots;
+        size_t head = 0, count = 0;
+        
+        void pushBack(Job &job)
+        {
+            if (count == slots.size())
+            {
+                std::vector<Job> grown(std::max<size_t>(slots.size() * 2, 64));
+                
+                for (size_t i = 0; i < count; i++)
+                    grown[i] = std::move(slots[(head + i) % slots.size()]);
+                
+                slots.swap(grown);
+                head = 0;
+            }
+            
+            slots[(head + count) % slots.size()] = std::move(job);
+            count++;
+        }
+        
+        bool popBack(Job &job)
+        {
+            if (count == 0)
+                return false;
+            
+            count--;
+            job = std::move(slots[(head + count) % slots.size()]);
+            
+            return true;
+        }
+        
+        bool popFront(Job &job)
+        {
+            if (count == 0)
+                return false;
+            
+            job = std::move(slots[head]);
+            head = (head + 1) % slots.size();
+            count--;
+            
+            return true;
+        }
+    };
+    
+    // Pushes to the calling worker's deque, or the shared one from any other thread
+    void push(Job job);
+    
+    // Pops the calling thread's newest job, or steals the oldest from another deque
+    bool findJob(Job &job);
+    
+    void execute(Job &job);
+    
+    void workerLoop(int workerIndex);
+    
+    std::vector<std::thread> mWorkers;
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+    
+    // Jobs queued but not yet taken, workers sleep while it is 0
+    std::atomic<int> mQueuedJobs;
+    
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    
+    std::deque<std::function<void()>> mBackgroundJobs;
+    
+    bool mRunning;
+};
+
+#endif /* jobSystem_hpp */
@@ -6,14 +6,89 @@
 //  Copyright © 2020 Keegan Bilodeau. All rights reserved.
 //
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include "application.hpp"
+#include "debug.hpp"
+#include "packArchive.hpp"
 
 int main(int argc, const char * argv[])
 {
     Application application;
     
+    // VIOLET_HEADLESS=<frames> or --headless <frames> runs a fixed number of frames without a window
+    if (const char *headlessFrames = std::getenv("VIOLET_HEADLESS"))
+        application.setHeadless(std::atoi(headlessFrames));
+    
+    // --pack <directory> <archive> builds a pack archive and exits without starting the game
+    if (argc >= 4 && std::strcmp(argv[1], "--pack") == 0)
+    {
+        bool packed = PackArchive::build(argv[2], argv[3]);
+        
+        Debug::flushLog();
+        
+        return packed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0 && i + 1 < argc)
+            application.setHeadless(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--benchmark") == 0)
+            application.setBenchmarkMode(i + 1 < argc && argv[i + 1][0] != '-' ? argv[++i] : "");
+        else if (std::strcmp(argv[i], "--autosave") == 0 && i + 1 < argc)
+        {
+            // --autosave <file> [seconds], resumes from the file and saves to it every few seconds
+            std::string savePath = argv[++i];
+            
+            application.setAutosave(savePath, i + 1 < argc && argv[i + 1][0] != '-' ? std::atof(argv[++i]) : 5.0);
+        }
+        else if (std::strcmp(argv[i], "--archive") == 0 && i + 1 < argc)
+        {
+            // --archive <file> [mount point], the mount point is the directory the archive was built from
+            std::string archivePath = argv[++i];
+            
+            application.addPackArchive(archivePath, i + 1 < argc && argv[i + 1][0] != '-' ? argv[++i] : "");
+        }
+        else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc)
+        {
+            // --texture-budget <megabytes>, for machines with little video memory
+            application.setTextureBudget(static_cast<size_t>(std::atof(argv[++i]) * 1024 * 1024));
+        }
+        else if (std::strcmp(argv[i], "--premultiply-alpha") == 0)
+            application.setPremultipliedAlpha(true);
+        else if (std::strcmp(argv[i], "--redraw-on-change") == 0)
+            application.setRedrawOnChange(true);
+        else if (std::strcmp(argv[i], "--present") == 0 && i + 1 < argc)
+        {
+            // --present <vsync|low-latency|immediate>
+            const char *presentPolicy = argv[++i];
+            
+            if (std::strcmp(presentPolicy, "low-latency") == 0)
+                application.setPresentPolicy(Application::PresentPolicy::LowLatency);
+            else if (std::strcmp(presentPolicy, "immediate") == 0)
+                application.setPresentPolicy(Application::PresentPolicy::Immediate);
+            else
+                application.setPresentPolicy(Application::PresentPolicy::VSync);
+        }
+        else if (std::strcmp(argv[i], "--late-input") == 0)
+            application.setLateInputSampling(true);
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            application.setInputRecording(argv[++i]);
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            // --replay <file>, runs the recorded session headlessly and reports its frame times
+            if (!application.setReplay(argv[++i]))
+            {
+                Debug::flushLog();
+                
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    
     if (application.run())
         return EXIT_SUCCESS;
     else
@@ -0,0 +1,145 @@
+//
+//  objectPool.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef objectPool_hpp
+#define objectPool_hpp
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <SDL.h>
+#include <stdio.h>
+#include <utility>
+#include <vector>
+
+// A fixed number of slots for one type, created and destroyed without touching the heap
+template <typename Object>
+class ObjectPool : public std::enable_shared_from_this<ObjectPool<Object>>
+{
+public:
+    // Reserves every slot up front
+    ObjectPool(size_t capacity) : mStorage(new Slot[capacity]), mCapacity(capacity), mLiveCount(0), mPeakCount(0), mFailedCount(0)
+    {
+        mFreeSlots.reserve(capacity);
+        
+        // Hand out the lowest slots first
+        for (size_t slot = capacity; slot > 0; slot--)
+            mFreeSlots.push_back(slot - 1);
+    }
+    
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    
+    // Every object must have been destroyed by now, the slots are released without running destructors
+    ~ObjectPool() = default;
+    
+    // Constructs an object in a free slot, returns nullptr when the pool is full
+    template <typename... Arguments>
+    Object* create(Arguments&&... arguments)
+    {
+        size_t slot;
+        
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            
+            if (mFreeSlots.empty())
+            {
+                mFailedCount++;
+                
+                return nullptr;
+            }
+            
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+            
+            mLiveCount++;
+            mPeakCount = std::max(mPeakCount, mLiveCount);
+        }
+        
+        return new (&mStorage[slot]) Object(std::forward<Arguments>(arguments)...);
+    }
+    
+    // Destroys an object created by this pool and frees its slot
+    void destroy(Object *object)
+    {
+        if (object == nullptr)
+            return;
+        
+        object->~Object();
+        
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        mFreeSlots.push_back(reinterpret_cast<Slot*>(object) - mStorage.get());
+        mLiveCount--;
+    }
+    
+    // Creates an object owned by a shared pointer that returns it to the pool, only the small control block is
+    // allocated, the pool must itself be owned by a shared pointer, which every object keeps alive
+    template <typename... Arguments>
+    std::shared_ptr<Object> makeShared(Arguments&&... arguments)
+    {
+        Object *object = create(std::forward<Arguments>(arguments)...);
+        
+        if (object == nullptr)
+            return nullptr;
+        
+        std::shared_ptr<ObjectPool> pool = this->shared_from_this();
+        
+        return std::shared_ptr<Object>(object, [pool](Object *pooledObject)
+        {
+            pool->destroy(pooledObject);
+        });
+    }
+    
+    // Returns the number of objects alive right now
+    size_t getLiveCount()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        return mLiveCount;
+    }
+    
+    // Returns the most objects that were ever alive at once, for sizing the pool
+    size_t getPeakCount()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        return mPeakCount;
+    }
+    
+    // Returns how many creations failed because the pool was full
+    size_t getFailedCount()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        
+        return mFailedCount;
+    }
+    
+    size_t getCapacity()
+    {
+        return mCapacity;
+    }
+
+private:
+    // Raw storage for one object
+    struct Slot
+    {
+        alignas(Object) unsigned char bytes[sizeof(Object)];
+    };
+    
+    std::unique_ptr<Slot[]> mStorage;
+    size_t mCapacity;
+    
+    std::mutex mMutex;
+    std::vector<size_t> mFreeSlots;
+    
+    size_t mLiveCount, mPeakCount, mFailedCount;
+};
+
+#endif /* objectPool_hpp */
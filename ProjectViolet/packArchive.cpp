@@ -0,0 +1,461 @@
+//
+//  packArchive.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "packArchive.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace
+{
+    // Both structs are written and read as raw bytes, which is little endian on every platform the game ships on
+    struct PackHeader
+    {
+        Uint32 magic;
+        Uint32 version;
+        Uint32 entryCount;
+        Uint32 bucketCount;
+        Uint64 bucketsOffset;
+        Uint64 recordsOffset;
+        Uint64 pathsOffset;
+    };
+    
+    struct PackRecord
+    {
+        Uint64 hash;
+        Uint64 dataOffset;
+        Uint64 storedSize;
+        Uint64 originalSize;
+        Uint32 pathOffset;
+        Uint32 pathLength;
+        Uint32 compression;
+        Uint32 reserved;
+    };
+    
+    static_assert(sizeof(PackHeader) == 40 && sizeof(PackRecord) == 48, "Pack structs must have no padding");
+    
+    const Uint32 EMPTY_BUCKET = 0xFFFFFFFF;
+    
+    // Entry data starts on this boundary so mapped entries can be read as any type
+    const Uint64 DATA_ALIGNMENT = 16;
+    
+    // Formats that are already compressed, zlib would only waste load time on them
+    const char *PRECOMPRESSED_EXTENSIONS[] = {".png", ".jpg", ".jpeg", ".ogg", ".opus"};
+    
+    template <typename Value>
+    Value readValue(const Uint8 *source)
+    {
+        Value value;
+        
+        std::memcpy(&value, source, sizeof(Value));
+        
+        return value;
+    }
+    
+    // A mounted archive and the path prefix it answers for
+    struct MountedPack
+    {
+        std::unique_ptr<PackArchive> archive;
+        std::string mountPoint;
+    };
+    
+    std::vector<MountedPack> mMountedPacks;
+}
+
+PackArchive::PackArchive() : mMapping(nullptr), mMappingSize(0), mEntryCount(0), mBucketCount(0), mBucketsOffset(0), mRecordsOffset(0), mPathsOffset(0)
+{
+    
+}
+
+PackArchive::~PackArchive()
+{
+    close();
+}
+
+Uint64 PackArchive::hashPath(const std::string &entryPath)
+{
+    Uint64 hash = 0xCBF29CE484222325ULL;
+    
+    for (char character : entryPath)
+    {
+        hash ^= static_cast<Uint8>(character);
+        hash *= 0x100000001B3ULL;
+    }
+    
+    return hash;
+}
+
+bool PackArchive::open(std::string archivePath)
+{
+    PROFILE_ZONE("PackArchive::open")
+    
+    close();
+    
+    int file = ::open(archivePath.c_str(), O_RDONLY);
+    
+    if (file < 0)
+    {
+        LOG_MESSAGE(SevereError, "Failed to open the pack archive %s!", archivePath.c_str())
+        
+        return false;
+    }
+    
+    struct stat fileInfo;
+    
+    if (fstat(file, &fileInfo) != 0 || fileInfo.st_size < static_cast<off_t>(sizeof(PackHeader)))
+    {
+        LOG_MESSAGE(SevereError, "%s is too small to be a pack archive!", archivePath.c_str())
+        
+        ::close(file);
+        
+        return false;
+    }
+    
+    void *mapping = mmap(nullptr, static_cast<size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    
+    // The mapping keeps the file alive on its own
+    ::close(file);
+    
+    if (mapping == MAP_FAILED)
+    {
+        LOG_MESSAGE(SevereError, "Failed to map the pack archive %s!", archivePath.c_str())
+        
+        return false;
+    }
+    
+    // Ask for the whole archive up front, so the reads are one sequential pass instead of a fault per asset
+    madvise(mapping, static_cast<size_t>(fileInfo.st_size), MADV_WILLNEED);
+    
+    mMapping = static_cast<const Uint8*>(mapping);
+    mMappingSize = static_cast<size_t>(fileInfo.st_size);
+    
+    PackHeader header = readValue<PackHeader>(mMapping);
+    
+    // Every part of the table of contents has to fit inside the file before anything is read from it
+    bool valid = header.magic == MAGIC && header.version == VERSION && header.bucketCount > 0 && (header.bucketCount & (header.bucketCount - 1)) == 0 &&
+                 header.bucketsOffset + static_cast<Uint64>(header.bucketCount) * sizeof(Uint32) <= mMappingSize &&
+                 header.recordsOffset + static_cast<Uint64>(header.entryCount) * sizeof(PackRecord) <= mMappingSize && header.pathsOffset <= mMappingSize;
+    
+    if (!valid)
+    {
+        LOG_MESSAGE(SevereError, "%s is not a valid version %u pack archive!", archivePath.c_str(), VERSION)
+        
+        close();
+        
+        return false;
+    }
+    
+    mEntryCount = header.entryCount;
+    mBucketCount = header.bucketCount;
+    mBucketsOffset = header.bucketsOffset;
+    mRecordsOffset = header.recordsOffset;
+    mPathsOffset = header.pathsOffset;
+    
+    return true;
+}
+
+void PackArchive::close()
+{
+    if (mMapping != nullptr)
+        munmap(const_cast<Uint8*>(mMapping), mMappingSize);
+    
+    mMapping = nullptr;
+    mMappingSize = 0;
+    mEntryCount = mBucketCount = 0;
+}
+
+long PackArchive::findRecord(const std::string &entryPath)
+{
+    if (mMapping == nullptr)
+        return -1;
+    
+    Uint64 hash = hashPath(entryPath);
+    
+    // Linear probing from the path's bucket until an empty one ends the search
+    for (Uint32 probe = 0; probe < mBucketCount; probe++)
+    {
+        Uint32 bucket = static_cast<Uint32>((hash + probe) & (mBucketCount - 1));
+        Uint32 index = readValue<Uint32>(mMapping + mBucketsOffset + bucket * sizeof(Uint32));
+        
+        if (index == EMPTY_BUCKET)
+            return -1;
+        
+        if (index >= mEntryCount)
+            continue;
+        
+        PackRecord record = readValue<PackRecord>(mMapping + mRecordsOffset + index * sizeof(PackRecord));
+        
+        // Equal hashes still need the paths compared
+        if (record.hash == hash && record.pathLength == entryPath.size() && mPathsOffset + record.pathOffset + record.pathLength <= mMappingSize &&
+            std::memcmp(mMapping + mPathsOffset + record.pathOffset, entryPath.data(), entryPath.size()) == 0)
+            return index;
+    }
+    
+    return -1;
+}
+
+bool PackArchive::contains(const std::string &entryPath)
+{
+    return findRecord(entryPath) >= 0;
+}
+
+bool PackArchive::findEntry(const std::string &entryPath, PackEntry &entry)
+{
+    long index = findRecord(entryPath);
+    
+    if (index < 0)
+        return false;
+    
+    PackRecord record = readValue<PackRecord>(mMapping + mRecordsOffset + index * sizeof(PackRecord));
+    
+    if (record.dataOffset + record.storedSize > mMappingSize)
+    {
+        LOG_MESSAGE(SevereError, "The pack entry %s runs past the end of its archive!", entryPath.c_str())
+        
+        return false;
+    }
+    
+    const Uint8 *storedData = mMapping + record.dataOffset;
+    
+    if (record.compression == Stored)
+    {
+        entry.data = storedData;
+        entry.size = static_cast<size_t>(record.storedSize);
+        entry.inflated.clear();
+        
+        return true;
+    }
+    
+    PROFILE_ZONE("PackArchive::inflate")
+    
+    entry.inflated.resize(static_cast<size_t>(record.originalSize));
+    
+    uLongf inflatedSize = static_cast<uLongf>(record.originalSize);
+    
+    if (record.compression != Zlib || uncompress(entry.inflated.data(), &inflatedSize, storedData, static_cast<uLong>(record.storedSize)) != Z_OK || inflatedSize != record.originalSize)
+    {
+        LOG_MESSAGE(SevereError, "Failed to decompress the pack entry %s!", entryPath.c_str())
+        
+        entry.inflated.clear();
+        
+        return false;
+    }
+    
+    entry.data = entry.inflated.data();
+    entry.size = entry.inflated.size();
+    
+    return true;
+}
+
+Uint32 PackArchive::getEntryCount()
+{
+    return mEntryCount;
+}
+
+bool PackArchive::isOpen()
+{
+    return mMapping != nullptr;
+}
+
+bool PackArchive::build(std::string sourceDirectory, std::string archivePath, bool compress)
+{
+    namespace filesystem = boost::filesystem;
+    
+    boost::system::error_code error;
+    
+    if (!filesystem::is_directory(sourceDirectory, error))
+    {
+        LOG_MESSAGE(SevereError, "%s is not a directory!", sourceDirectory.c_str())
+        
+        return false;
+    }
+    
+    // Sorted so the same directory always produces the same archive
+    std::vector<filesystem::path> files;
+    
+    for (filesystem::recursive_directory_iterator file(sourceDirectory, error), end; file != end && !error; file.increment(error))
+    {
+        if (filesystem::is_regular_file(file->path()))
+            files.push_back(file->path());
+    }
+    
+    std::sort(files.begin(), files.end());
+    
+    std::ofstream archive(archivePath, std::ios::binary | std::ios::trunc);
+    
+    if (!archive)
+    {
+        LOG_MESSAGE(SevereError, "Failed to create the pack archive %s!", archivePath.c_str())
+        
+        return false;
+    }
+    
+    // The header is written last, once the table's offsets are known
+    PackHeader header = {MAGIC, VERSION, 0, 0, 0, 0, 0};
+    archive.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    std::vector<PackRecord> records;
+    std::string paths;
+    Uint64 offset = sizeof(header);
+    
+    for (const filesystem::path &file : files)
+    {
+        std::string entryPath = filesystem::relative(file, sourceDirectory).generic_string();
+        
+        std::ifstream input(file.string(), std::ios::binary);
+        std::vector<Uint8> contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        
+        if (!input.good() && !input.eof())
+        {
+            LOG_MESSAGE(SevereError, "Failed to read %s!", file.string().c_str())
+            
+            return false;
+        }
+        
+        PackRecord record = {hashPath(entryPath), 0, contents.size(), contents.size(), static_cast<Uint32>(paths.size()), static_cast<Uint32>(entryPath.size()), Stored, 0};
+        
+        std::string extension = file.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        
+        bool precompressed = std::find(std::begin(PRECOMPRESSED_EXTENSIONS), std::end(PRECOMPRESSED_EXTENSIONS), extension) != std::end(PRECOMPRESSED_EXTENSIONS);
+        
+        std::vector<Uint8> compressed;
+        
+        // Only keep the compressed copy when it saves at least a tenth, inflating isn't free
+        if (compress && !precompressed && !contents.empty())
+        {
+            uLongf compressedSize = compressBound(static_cast<uLong>(contents.size()));
+            compressed.resize(compressedSize);
+            
+            if (compress2(compressed.data(), &compressedSize, contents.data(), static_cast<uLong>(contents.size()), Z_BEST_COMPRESSION) == Z_OK && compressedSize < contents.size() - contents.size() / 10)
+            {
+                compressed.resize(compressedSize);
+                
+                record.compression = Zlib;
+                record.storedSize = compressedSize;
+            }
+        }
+        
+        const std::vector<Uint8> &stored = record.compression == Zlib ? compressed : contents;
+        
+        // Pad up to the next aligned offset
+        Uint64 padding = (DATA_ALIGNMENT - offset % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+        
+        for (Uint64 i = 0; i < padding; i++)
+            archive.put(0);
+        
+        offset += padding;
+        record.dataOffset = offset;
+        
+        archive.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+        offset += stored.size();
+        
+        records.push_back(record);
+        paths += entryPath;
+    }
+    
+    // At most half full, so probe sequences stay short
+    Uint32 bucketCount = 16;
+    
+    while (bucketCount < records.size() * 2)
+        bucketCount *= 2;
+    
+    std::vector<Uint32> buckets(bucketCount, EMPTY_BUCKET);
+    
+    for (Uint32 index = 0; index < records.size(); index++)
+    {
+        Uint32 bucket = static_cast<Uint32>(records[index].hash & (bucketCount - 1));
+        
+        while (buckets[bucket] != EMPTY_BUCKET)
+            bucket = (bucket + 1) & (bucketCount - 1);
+        
+        buckets[bucket] = index;
+    }
+    
+    header.entryCount = static_cast<Uint32>(records.size());
+    header.bucketCount = bucketCount;
+    header.bucketsOffset = offset;
+    header.recordsOffset = header.bucketsOffset + buckets.size() * sizeof(Uint32);
+    header.pathsOffset = header.recordsOffset + records.size() * sizeof(PackRecord);
+    
+    archive.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(Uint32)));
+    archive.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(PackRecord)));
+    archive.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+    
+    archive.seekp(0);
+    archive.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    if (!archive)
+    {
+        LOG_MESSAGE(SevereError, "Failed to write the pack archive %s!", archivePath.c_str())
+        
+        return false;
+    }
+    
+    LOG_MESSAGE(Information, "Packed %u files into %s", header.entryCount, archivePath.c_str())
+    
+    return true;
+}
+
+namespace AssetPack
+{
+    bool mount(std::string archivePath, std::string mountPoint)
+    {
+        std::unique_ptr<PackArchive> archive = std::make_unique<PackArchive>();
+        
+        if (!archive->open(archivePath))
+            return false;
+        
+        // "assets" and "assets/" mean the same directory
+        if (!mountPoint.empty() && mountPoint.back() != '/')
+            mountPoint += '/';
+        
+        mMountedPacks.push_back({std::move(archive), mountPoint});
+        
+        return true;
+    }
+    
+    void unmountAll()
+    {
+        mMountedPacks.clear();
+    }
+    
+    bool findFile(const std::string &filePath, PackEntry &entry)
+    {
+        // Archives mounted later override earlier ones
+        for (auto pack = mMountedPacks.rbegin(); pack != mMountedPacks.rend(); ++pack)
+        {
+            if (filePath.compare(0, pack->mountPoint.size(), pack->mountPoint) != 0)
+                continue;
+            
+            if (pack->archive->findEntry(filePath.substr(pack->mountPoint.size()), entry))
+                return true;
+        }
+        
+        return false;
+    }
+    
+    SDL_RWops* openFile(const std::string &filePath, PackEntry &entry)
+    {
+        if (findFile(filePath, entry))
+            return SDL_RWFromConstMem(entry.data, static_cast<int>(entry.size));
+        
+        return SDL_RWFromFile(filePath.c_str(), "rb");
+    }
+}
@@ -0,0 +1,108 @@
+//
+//  packArchive.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef packArchive_hpp
+#define packArchive_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// An entry's bytes, pointing straight into the archive's mapping unless the entry had to be inflated
+struct PackEntry
+{
+    const Uint8 *data = nullptr;
+    size_t size = 0;
+    
+    // Holds the decompressed bytes of compressed entries, must outlive anything reading data
+    std::vector<Uint8> inflated;
+};
+
+// A read-only, memory-mapped archive of assets with a hashed table of contents
+//
+// Layout (little endian): a header, every entry's data, then the table of contents made of an
+// open addressing bucket array of entry indices, the entry records and finally their path strings
+class PackArchive
+{
+public:
+    static const Uint32 MAGIC = 0x4B415056; // "VPAK"
+    static const Uint32 VERSION = 1;
+    
+    enum Compression
+    {
+        Stored,
+        Zlib
+    };
+    
+    // Initializes a closed archive
+    PackArchive();
+    
+    // Unmaps the archive
+    ~PackArchive();
+    
+    PackArchive(const PackArchive&) = delete;
+    PackArchive& operator=(const PackArchive&) = delete;
+    
+    // Maps an archive and checks its table of contents
+    bool open(std::string archivePath);
+    
+    // Unmaps the archive, any uninflated PackEntry taken from it becomes invalid
+    void close();
+    
+    // Returns whether an entry exists, paths are relative to the directory the archive was built from
+    bool contains(const std::string &entryPath);
+    
+    // Finds an entry's bytes, only copying if it was compressed, safe to call from any thread
+    bool findEntry(const std::string &entryPath, PackEntry &entry);
+    
+    // Returns the number of entries in the archive
+    Uint32 getEntryCount();
+    
+    // Returns whether an archive is mapped
+    bool isOpen();
+    
+    // Packs every file under a directory into an archive, compressing the entries zlib shrinks enough
+    static bool build(std::string sourceDirectory, std::string archivePath, bool compress = true);
+    
+    // 64 bit FNV-1a of a path, used for the table of contents
+    static Uint64 hashPath(const std::string &entryPath);
+
+private:
+    // Returns the index of the entry's record, or -1 if it isn't in the archive
+    long findRecord(const std::string &entryPath);
+    
+    // Start and size of the mapping
+    const Uint8 *mMapping;
+    size_t mMappingSize;
+    
+    Uint32 mEntryCount, mBucketCount;
+    
+    // Offsets of the table of contents' parts inside the mapping
+    Uint64 mBucketsOffset, mRecordsOffset, mPathsOffset;
+};
+
+// The archives mounted for the game, consulted by every asset loader before the file system
+namespace AssetPack
+{
+    // Mounts an archive so files under mountPoint (e.g. "assets/") are read from it,
+    // must only be called while no loader threads are reading
+    bool mount(std::string archivePath, std::string mountPoint = "");
+    
+    // Unmounts every archive, with the same threading rule as mount
+    void unmountAll();
+    
+    // Finds a file in the mounted archives, returns false if no archive has it
+    bool findFile(const std::string &filePath, PackEntry &entry);
+    
+    // Opens a file from the mounted archives without copying it, or from disk if no archive has it,
+    // entry holds the bytes and must outlive the returned stream
+    SDL_RWops* openFile(const std::string &filePath, PackEntry &entry);
+}
+
+#endif /* packArchive_hpp */
@@ -0,0 +1,609 @@
+//
+//  particleSystem.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "particleSystem.hpp"
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VIOLET_X86_KERNELS
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define VIOLET_NEON_KERNELS
+#endif
+
+namespace
+{
+    // Pointers into one emitter's attribute arrays
+    struct ParticleArrays
+    {
+        float *positionX, *positionY;
+        float *velocityX, *velocityY;
+        float *age, *inverseLifetime;
+        float *size;
+        SDL_Color *color;
+    };
+    
+    // Everything that is the same for every particle of an emitter during a step
+    struct StepConstants
+    {
+        float step;
+        float accelerationX, accelerationY;
+        
+        // Velocity is multiplied by this each step, drag turned into a factor once rather than per particle
+        float damping;
+        
+        float startSize, sizeChange;
+        float startColor[4], colorChange[4];
+    };
+    
+    typedef void (*IntegrateKernel)(const ParticleArrays &particles, int count, const StepConstants &constants);
+    
+    // Rounds the particle count up to whole groups of four, the arrays are padded to match
+    inline int paddedCount(int count)
+    {
+        return (count + 3) & ~3;
+    }
+    
+    void integrateScalar(const ParticleArrays &particles, int count, const StepConstants &constants)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            particles.velocityX[i] = (particles.velocityX[i] + constants.accelerationX * constants.step) * constants.damping;
+            particles.velocityY[i] = (particles.velocityY[i] + constants.accelerationY * constants.step) * constants.damping;
+            
+            particles.positionX[i] += particles.velocityX[i] * constants.step;
+            particles.positionY[i] += particles.velocityY[i] * constants.step;
+            
+            particles.age[i] += constants.step;
+            
+            // How far through its life the particle is, dead ones are held at the end values until they are removed
+            float life = std::min(particles.age[i] * particles.inverseLifetime[i], 1.0f);
+            
+            particles.size[i] = constants.startSize + constants.sizeChange * life;
+            
+            particles.color[i].r = static_cast<Uint8>(constants.startColor[0] + constants.colorChange[0] * life + 0.5f);
+            particles.color[i].g = static_cast<Uint8>(constants.startColor[1] + constants.colorChange[1] * life + 0.5f);
+            particles.color[i].b = static_cast<Uint8>(constants.startColor[2] + constants.colorChange[2] * life + 0.5f);
+            particles.color[i].a = static_cast<Uint8>(constants.startColor[3] + constants.colorChange[3] * life + 0.5f);
+        }
+    }
+
+#ifdef VIOLET_X86_KERNELS
+    void integrateSSE2(const ParticleArrays &particles, int count, const StepConstants &constants)
+    {
+        const __m128 step = _mm_set1_ps(constants.step);
+        const __m128 accelerationX = _mm_set1_ps(constants.accelerationX * constants.step);
+        const __m128 accelerationY = _mm_set1_ps(constants.accelerationY * constants.step);
+        const __m128 damping = _mm_set1_ps(constants.damping);
+        const __m128 one = _mm_set1_ps(1.0f);
+        
+        const __m128 startSize = _mm_set1_ps(constants.startSize);
+        const __m128 sizeChange = _mm_set1_ps(constants.sizeChange);
+        
+        __m128 startColor[4], colorChange[4];
+        
+        for (int channel = 0; channel < 4; channel++)
+        {
+            startColor[channel] = _mm_set1_ps(constants.startColor[channel]);
+            colorChange[channel] = _mm_set1_ps(constants.colorChange[channel]);
+        }
+        
+        for (int i = 0; i < count; i += 4)
+        {
+            __m128 velocityX = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(particles.velocityX + i), accelerationX), damping);
+            __m128 velocityY = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(particles.velocityY + i), accelerationY), damping);
+            
+            _mm_storeu_ps(particles.velocityX + i, velocityX);
+            _mm_storeu_ps(particles.velocityY + i, velocityY);
+            
+            _mm_storeu_ps(particles.positionX + i, _mm_add_ps(_mm_loadu_ps(particles.positionX + i), _mm_mul_ps(velocityX, step)));
+            _mm_storeu_ps(particles.positionY + i, _mm_add_ps(_mm_loadu_ps(particles.positionY + i), _mm_mul_ps(velocityY, step)));
+            
+            __m128 age = _mm_add_ps(_mm_loadu_ps(particles.age + i), step);
+            
+            _mm_storeu_ps(particles.age + i, age);
+            
+            __m128 life = _mm_min_ps(_mm_mul_ps(age, _mm_loadu_ps(particles.inverseLifetime + i)), one);
+            
+            _mm_storeu_ps(particles.size + i, _mm_add_ps(startSize, _mm_mul_ps(sizeChange, life)));
+            
+            // Each channel lands in its own byte of the 32 bit lane, which on a little endian CPU is SDL_Color's layout
+            __m128i color = _mm_setzero_si128();
+            
+            for (int channel = 0; channel < 4; channel++)
+            {
+                __m128i value = _mm_cvtps_epi32(_mm_add_ps(startColor[channel], _mm_mul_ps(colorChange[channel], life)));
+                
+                color = _mm_or_si128(color, _mm_slli_epi32(value, channel * 8));
+            }
+            
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(particles.color + i), color);
+        }
+    }
+#endif
+
+#ifdef VIOLET_NEON_KERNELS
+    void integrateNEON(const ParticleArrays &particles, int count, const StepConstants &constants)
+    {
+        const float32x4_t step = vdupq_n_f32(constants.step);
+        const float32x4_t accelerationX = vdupq_n_f32(constants.accelerationX * constants.step);
+        const float32x4_t accelerationY = vdupq_n_f32(constants.accelerationY * constants.step);
+        const float32x4_t damping = vdupq_n_f32(constants.damping);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        
+        const float32x4_t startSize = vdupq_n_f32(constants.startSize);
+        const float32x4_t sizeChange = vdupq_n_f32(constants.sizeChange);
+        
+        float32x4_t startColor[4], colorChange[4];
+        
+        for (int channel = 0; channel < 4; channel++)
+        {
+            startColor[channel] = vdupq_n_f32(constants.startColor[channel]);
+            colorChange[channel] = vdupq_n_f32(constants.colorChange[channel]);
+        }
+        
+        for (int i = 0; i < count; i += 4)
+        {
+            float32x4_t velocityX = vmulq_f32(vaddq_f32(vld1q_f32(particles.velocityX + i), accelerationX), damping);
+            float32x4_t velocityY = vmulq_f32(vaddq_f32(vld1q_f32(particles.velocityY + i), accelerationY), damping);
+            
+            vst1q_f32(particles.velocityX + i, velocityX);
+            vst1q_f32(particles.velocityY + i, velocityY);
+            
+            vst1q_f32(particles.positionX + i, vmlaq_f32(vld1q_f32(particles.positionX + i), velocityX, step));
+            vst1q_f32(particles.positionY + i, vmlaq_f32(vld1q_f32(particles.positionY + i), velocityY, step));
+            
+            float32x4_t age = vaddq_f32(vld1q_f32(particles.age + i), step);
+            
+            vst1q_f32(particles.age + i, age);
+            
+            float32x4_t life = vminq_f32(vmulq_f32(age, vld1q_f32(particles.inverseLifetime + i)), one);
+            
+            vst1q_f32(particles.size + i, vmlaq_f32(startSize, sizeChange, life));
+            
+            uint32x4_t color = vdupq_n_u32(0);
+            
+            color = vorrq_u32(color, vcvtnq_u32_f32(vmlaq_f32(startColor[0], colorChange[0], life)));
+            color = vorrq_u32(color, vshlq_n_u32(vcvtnq_u32_f32(vmlaq_f32(startColor[1], colorChange[1], life)), 8));
+            color = vorrq_u32(color, vshlq_n_u32(vcvtnq_u32_f32(vmlaq_f32(startColor[2], colorChange[2], life)), 16));
+            color = vorrq_u32(color, vshlq_n_u32(vcvtnq_u32_f32(vmlaq_f32(startColor[3], colorChange[3], life)), 24));
+            
+            vst1q_u32(reinterpret_cast<uint32_t*>(particles.color + i), color);
+        }
+    }
+#endif
+
+    IntegrateKernel findIntegrateKernel(ParticleSystem::Kernel kernel)
+    {
+#ifdef VIOLET_X86_KERNELS
+        if (kernel == ParticleSystem::Kernel::SSE2)
+            return integrateSSE2;
+#endif
+
+#ifdef VIOLET_NEON_KERNELS
+        if (kernel == ParticleSystem::Kernel::NEON)
+            return integrateNEON;
+#endif
+
+        return integrateScalar;
+    }
+}
+
+ParticleSystem::ParticleSystem() : mKernel(getBestKernel()), mRandomState(0x9E3779B9), mLiveCount(0), mLastDrawnCount(0)
+{
+    
+}
+
+ParticleSystem::Kernel ParticleSystem::getBestKernel()
+{
+#ifdef VIOLET_X86_KERNELS
+    if (SDL_HasSSE2())
+        return Kernel::SSE2;
+#endif
+
+#ifdef VIOLET_NEON_KERNELS
+    if (SDL_HasNEON())
+        return Kernel::NEON;
+#endif
+
+    return Kernel::Scalar;
+}
+
+void ParticleSystem::setKernel(Kernel kernel)
+{
+    // Each CPU supports at most one of the vector kernels, so anything but scalar means the best one
+    mKernel = kernel == Kernel::Scalar ? Kernel::Scalar : getBestKernel();
+}
+
+ParticleSystem::Kernel ParticleSystem::getKernel()
+{
+    return mKernel;
+}
+
+const char* ParticleSystem::getKernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+        case Kernel::NEON:
+            return "neon";
+        
+        case Kernel::SSE2:
+            return "sse2";
+        
+        default:
+            return "scalar";
+    }
+}
+
+int ParticleSystem::createEmitter(const EmitterSettings &settings, float x, float y)
+{
+    int id;
+    
+    if (mFreeEmitters.empty())
+    {
+        id = static_cast<int>(mEmitters.size());
+        mEmitters.emplace_back();
+    }
+    else
+    {
+        id = mFreeEmitters.back();
+        mFreeEmitters.pop_back();
+    }
+    
+    Emitter &emitter = mEmitters[id];
+    
+    emitter.settings = settings;
+    emitter.settings.capacity = std::max(settings.capacity, 1);
+    emitter.x = x;
+    emitter.y = y;
+    emitter.active = true;
+    emitter.emitting = true;
+    emitter.spawnAccumulator = 0.0f;
+    emitter.count = 0;
+    
+    // Every array is sized once here, so updating and drawing never allocate
+    size_t storage = paddedCount(emitter.settings.capacity);
+    
+    emitter.positionX.assign(storage, 0.0f);
+    emitter.positionY.assign(storage, 0.0f);
+    emitter.velocityX.assign(storage, 0.0f);
+    emitter.velocityY.assign(storage, 0.0f);
+    emitter.age.assign(storage, 0.0f);
+    emitter.inverseLifetime.assign(storage, 0.0f);
+    emitter.size.assign(storage, 0.0f);
+    emitter.color.assign(storage, {0, 0, 0, 0});
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (mVertices.size() < storage * 4)
+        mVertices.resize(storage * 4);
+    
+    // Two triangles per quad, the same for every emitter, so the indices are built once for the largest one
+    for (int quad = static_cast<int>(mIndices.size() / 6); quad < static_cast<int>(storage); quad++)
+    {
+        int firstVertex = quad * 4;
+        
+        mIndices.insert(mIndices.end(), {firstVertex, firstVertex + 1, firstVertex + 2, firstVertex, firstVertex + 2, firstVertex + 3});
+    }
+#endif
+
+    return id;
+}
+
+void ParticleSystem::destroyEmitter(int emitter)
+{
+    Emitter *destroyed = findEmitter(emitter);
+    
+    if (destroyed == nullptr)
+        return;
+    
+    mLiveCount -= destroyed->count;
+    
+    // Release the storage, a new emitter in this slot may need a different capacity
+    *destroyed = Emitter();
+    destroyed->active = false;
+    
+    mFreeEmitters.push_back(emitter);
+}
+
+void ParticleSystem::setEmitterPosition(int emitter, float x, float y)
+{
+    if (Emitter *moved = findEmitter(emitter))
+    {
+        moved->x = x;
+        moved->y = y;
+    }
+}
+
+void ParticleSystem::setEmitting(int emitter, bool emitting)
+{
+    if (Emitter *toggled = findEmitter(emitter))
+    {
+        toggled->emitting = emitting;
+        toggled->spawnAccumulator = 0.0f;
+    }
+}
+
+void ParticleSystem::burst(int emitter, int count)
+{
+    if (Emitter *bursting = findEmitter(emitter))
+        spawn(*bursting, count);
+}
+
+ParticleSystem::Emitter* ParticleSystem::findEmitter(int emitter)
+{
+    if (emitter < 0 || emitter >= static_cast<int>(mEmitters.size()) || !mEmitters[emitter].active)
+        return nullptr;
+    
+    return &mEmitters[emitter];
+}
+
+float ParticleSystem::randomUnit()
+{
+    // xorshift32, plenty for scattering particles and cheap enough to call several times per spawn
+    mRandomState ^= mRandomState << 13;
+    mRandomState ^= mRandomState >> 17;
+    mRandomState ^= mRandomState << 5;
+    
+    return (mRandomState >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::spawn(Emitter &emitter, int count)
+{
+    const EmitterSettings &settings = emitter.settings;
+    
+    // Spawns that don't fit are dropped rather than replacing particles still alive
+    count = std::min(count, settings.capacity - emitter.count);
+    
+    const float degreesToRadians = static_cast<float>(M_PI / 180.0);
+    
+    for (int spawned = 0; spawned < count; spawned++)
+    {
+        int i = emitter.count++;
+        
+        float angle = (settings.direction + (randomUnit() - 0.5f) * settings.spread) * degreesToRadians;
+        float speed = settings.speed + (randomUnit() * 2.0f - 1.0f) * settings.speedVariance;
+        float lifetime = std::max(settings.lifetime + (randomUnit() * 2.0f - 1.0f) * settings.lifetimeVariance, 0.001f);
+        
+        emitter.positionX[i] = emitter.x;
+        emitter.positionY[i] = emitter.y;
+        emitter.velocityX[i] = std::cos(angle) * speed;
+        emitter.velocityY[i] = std::sin(angle) * speed;
+        emitter.age[i] = 0.0f;
+        emitter.inverseLifetime[i] = 1.0f / lifetime;
+        emitter.size[i] = settings.startSize;
+        emitter.color[i] = settings.startColor;
+    }
+    
+    mLiveCount += count;
+}
+
+void ParticleSystem::update(double deltaTime)
+{
+    PROFILE_ZONE("ParticleSystem::update")
+    
+    const float step = static_cast<float>(deltaTime);
+    
+    IntegrateKernel integrate = findIntegrateKernel(mKernel);
+    
+    for (Emitter &emitter : mEmitters)
+    {
+        if (!emitter.active)
+            continue;
+        
+        const EmitterSettings &settings = emitter.settings;
+        
+        if (emitter.count > 0)
+        {
+            StepConstants constants;
+            
+            constants.step = step;
+            constants.accelerationX = settings.accelerationX;
+            constants.accelerationY = settings.accelerationY;
+            constants.damping = std::max(1.0f - settings.drag * step, 0.0f);
+            constants.startSize = settings.startSize;
+            constants.sizeChange = settings.endSize - settings.startSize;
+            
+            const Uint8 startColor[4] = {settings.startColor.r, settings.startColor.g, settings.startColor.b, settings.startColor.a};
+            const Uint8 endColor[4] = {settings.endColor.r, settings.endColor.g, settings.endColor.b, settings.endColor.a};
+            
+            for (int channel = 0; channel < 4; channel++)
+            {
+                constants.startColor[channel] = startColor[channel];
+                constants.colorChange[channel] = static_cast<float>(endColor[channel]) - startColor[channel];
+            }
+            
+            ParticleArrays particles = {emitter.positionX.data(), emitter.positionY.data(), emitter.velocityX.data(), emitter.velocityY.data(), emitter.age.data(), emitter.inverseLifetime.data(), emitter.size.data(), emitter.color.data()};
+            
+            // The padding lanes past the last particle are stepped too, which is cheaper than a tail loop
+            integrate(particles, paddedCount(emitter.count), constants);
+            
+            // Dead particles are swap-removed, so the live ones stay packed at the front without keeping any order
+            int count = emitter.count;
+            
+            for (int i = 0; i < count;)
+            {
+                if (emitter.age[i] * emitter.inverseLifetime[i] < 1.0f)
+                {
+                    i++;
+                    
+                    continue;
+                }
+                
+                int last = --count;
+                
+                emitter.positionX[i] = emitter.positionX[last];
+                emitter.positionY[i] = emitter.positionY[last];
+                emitter.velocityX[i] = emitter.velocityX[last];
+                emitter.velocityY[i] = emitter.velocityY[last];
+                emitter.age[i] = emitter.age[last];
+                emitter.inverseLifetime[i] = emitter.inverseLifetime[last];
+                emitter.size[i] = emitter.size[last];
+                emitter.color[i] = emitter.color[last];
+            }
+            
+            mLiveCount -= emitter.count - count;
+            emitter.count = count;
+        }
+        
+        if (emitter.emitting && settings.rate > 0.0f)
+        {
+            emitter.spawnAccumulator += settings.rate * step;
+            
+            int spawnCount = static_cast<int>(emitter.spawnAccumulator);
+            
+            emitter.spawnAccumulator -= spawnCount;
+            
+            spawn(emitter, spawnCount);
+        }
+    }
+    
+    PROFILE_COUNTER("Live particles", mLiveCount)
+}
+
+void ParticleSystem::render(SDL_Renderer *renderer, const SDL_Rect &camera, float elapsed)
+{
+    PROFILE_ZONE("ParticleSystem::render")
+    
+    mLastDrawnCount = 0;
+    
+    for (Emitter &emitter : mEmitters)
+    {
+        if (!emitter.active || emitter.count == 0 || !emitter.settings.texture)
+            continue;
+        
+        const EmitterSettings &settings = emitter.settings;
+        
+        SDL_Texture *texture = settings.texture->getTexture();
+        
+        if (texture == nullptr)
+            continue;
+        
+        SDL_Rect source = settings.source;
+        
+        if (source.w <= 0 || source.h <= 0)
+            source = {0, 0, settings.texture->getWidth(), settings.texture->getHeight()};
+        
+        // The texture may be shared with sprites, so its blend mode is put back once the particles are drawn
+        SDL_BlendMode previousBlendMode = SDL_BLENDMODE_BLEND;
+        
+        SDL_GetTextureBlendMode(texture, &previousBlendMode);
+        SDL_SetTextureBlendMode(texture, settings.blendMode);
+        
+        const float left = static_cast<float>(camera.x), top = static_cast<float>(camera.y);
+        const float right = left + camera.w, bottom = top + camera.h;
+        
+        int drawn = 0;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        float inverseWidth = 1.0f / settings.texture->getWidth();
+        float inverseHeight = 1.0f / settings.texture->getHeight();
+        
+        float u0 = source.x * inverseWidth, v0 = source.y * inverseHeight;
+        float u1 = (source.x + source.w) * inverseWidth, v1 = (source.y + source.h) * inverseHeight;
+        
+        SDL_Vertex *vertex = mVertices.data();
+        
+        for (int i = 0; i < emitter.count; i++)
+        {
+            float halfSize = emitter.size[i] * 0.5f;
+            
+            // Centered on the particle, carried on by the time since the last update
+            float x = emitter.positionX[i] + emitter.velocityX[i] * elapsed;
+            float y = emitter.positionY[i] + emitter.velocityY[i] * elapsed;
+            
+            if (x + halfSize < left || x - halfSize > right || y + halfSize < top || y - halfSize > bottom)
+                continue;
+            
+            float minX = x - halfSize - left, minY = y - halfSize - top;
+            float maxX = x + halfSize - left, maxY = y + halfSize - top;
+            
+            SDL_Color color = emitter.color[i];
+            
+            vertex[0] = {{minX, minY}, color, {u0, v0}};
+            vertex[1] = {{maxX, minY}, color, {u1, v0}};
+            vertex[2] = {{maxX, maxY}, color, {u1, v1}};
+            vertex[3] = {{minX, maxY}, color, {u0, v1}};
+            
+            vertex += 4;
+            drawn++;
+        }
+        
+        // The emitter's whole pool goes out in one vertex array draw
+        if (drawn > 0)
+            SDL_RenderGeometry(renderer, texture, mVertices.data(), drawn * 4, mIndices.data(), drawn * 6);
+#else
+        // Without SDL_RenderGeometry the quads are still submitted back to back on one texture, which
+        // SDL's render batching merges into few draw calls, and color mods are only changed when needed
+        SDL_Color currentColor = {0xFF, 0xFF, 0xFF, 0xFF};
+        
+        SDL_SetTextureColorMod(texture, currentColor.r, currentColor.g, currentColor.b);
+        SDL_SetTextureAlphaMod(texture, currentColor.a);
+        
+        for (int i = 0; i < emitter.count; i++)
+        {
+            float halfSize = emitter.size[i] * 0.5f;
+            
+            float x = emitter.positionX[i] + emitter.velocityX[i] * elapsed;
+            float y = emitter.positionY[i] + emitter.velocityY[i] * elapsed;
+            
+            if (x + halfSize < left || x - halfSize > right || y + halfSize < top || y - halfSize > bottom)
+                continue;
+            
+            SDL_Color color = emitter.color[i];
+            
+            if (color.r != currentColor.r || color.g != currentColor.g || color.b != currentColor.b || color.a != currentColor.a)
+            {
+                currentColor = color;
+                
+                SDL_SetTextureColorMod(texture, currentColor.r, currentColor.g, currentColor.b);
+                SDL_SetTextureAlphaMod(texture, currentColor.a);
+            }
+            
+            SDL_FRect destination = {x - halfSize - left, y - halfSize - top, halfSize * 2.0f, halfSize * 2.0f};
+            
+            SDL_RenderCopyF(renderer, texture, &source, &destination);
+            
+            drawn++;
+        }
+        
+        SDL_SetTextureColorMod(texture, 0xFF, 0xFF, 0xFF);
+        SDL_SetTextureAlphaMod(texture, 0xFF);
+#endif
+
+        SDL_SetTextureBlendMode(texture, previousBlendMode);
+        
+        mLastDrawnCount += drawn;
+    }
+    
+    PROFILE_COUNTER("Drawn particles", mLastDrawnCount)
+}
+
+void ParticleSystem::clear()
+{
+    mEmitters.clear();
+    mFreeEmitters.clear();
+    
+    mLiveCount = 0;
+}
+
+int ParticleSystem::getLiveCount()
+{
+    return mLiveCount;
+}
+
+int ParticleSystem::getLastDrawnCount()
+{
+    return mLastDrawnCount;
+}
@@ -0,0 +1,158 @@
+//
+//  particleSystem.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef particleSystem_hpp
+#define particleSystem_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+#include "assetManager.hpp"
+
+// How an emitter spawns its particles and how they change over their lives, distances are in world pixels,
+// times in seconds and angles in degrees
+struct EmitterSettings
+{
+    std::shared_ptr<TextureAsset> texture;
+    
+    // Part of the texture each particle shows, the whole texture if empty
+    SDL_Rect source = {0, 0, 0, 0};
+    
+    // Most particles alive at once, storage for all of them is allocated when the emitter is created
+    int capacity = 1024;
+    
+    // Particles spawned per second while emitting
+    float rate = 100.0f;
+    
+    float lifetime = 1.0f, lifetimeVariance = 0.0f;
+    float speed = 50.0f, speedVariance = 0.0f;
+    
+    // Particles leave within spread degrees around the direction, 0 is to the right and 90 is down
+    float direction = 0.0f, spread = 360.0f;
+    
+    // Gravity, wind and the like, in pixels per second squared
+    float accelerationX = 0.0f, accelerationY = 0.0f;
+    
+    // Fraction of its velocity a particle loses per second
+    float drag = 0.0f;
+    
+    // Size and color are blended from the start to the end value over a particle's life
+    float startSize = 8.0f, endSize = 8.0f;
+    SDL_Color startColor = {0xFF, 0xFF, 0xFF, 0xFF}, endColor = {0xFF, 0xFF, 0xFF, 0x00};
+    
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+};
+
+// Simulates effects made of many short lived quads, each emitter keeps its particles in fixed size arrays per
+// attribute that are stepped four at a time and drawn as one vertex batch, main thread only
+class ParticleSystem
+{
+public:
+    // Integration kernels, a vector kernel is only used if the CPU supports it
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        NEON
+    };
+    
+    // Initializes a system without emitters using the fastest kernel
+    ParticleSystem();
+    
+    // Returns the fastest kernel this CPU supports
+    static Kernel getBestKernel();
+    
+    // Forces a kernel for the following updates, unsupported kernels fall back to the best supported one
+    void setKernel(Kernel kernel);
+    
+    // Returns the kernel updates currently use
+    Kernel getKernel();
+    
+    // Returns the kernel's name for logs and benchmark results
+    static const char* getKernelName(Kernel kernel);
+    
+    // Creates an emitter at a position in the world and returns its id, it starts out emitting
+    int createEmitter(const EmitterSettings &settings, float x, float y);
+    
+    // Destroys an emitter and its particles, its id may be handed out again
+    void destroyEmitter(int emitter);
+    
+    // Moves where new particles spawn, particles already alive carry on where they are
+    void setEmitterPosition(int emitter, float x, float y);
+    
+    // Starts or stops spawning at the emitter's rate, particles already alive live out their lifetime
+    void setEmitting(int emitter, bool emitting);
+    
+    // Spawns a number of particles at once, for hit flashes and explosions
+    void burst(int emitter, int count);
+    
+    // Steps every particle by one fixed step of deltaTime seconds, removes the ones that died and spawns new ones
+    void update(double deltaTime);
+    
+    // Draws every emitter's particles relative to the camera, one vertex batch per emitter, moved on by
+    // elapsed seconds so they keep up with the interpolated sprites
+    void render(SDL_Renderer *renderer, const SDL_Rect &camera, float elapsed);
+    
+    // Destroys every emitter, must be called before the renderer is destroyed
+    void clear();
+    
+    // Returns the number of particles alive across every emitter
+    int getLiveCount();
+    
+    // Returns the number of particles drawn by the last render
+    int getLastDrawnCount();
+
+private:
+    struct Emitter
+    {
+        EmitterSettings settings;
+        
+        float x, y;
+        bool active, emitting;
+        
+        // Spawns owed to the rate that haven't made up a whole particle yet
+        float spawnAccumulator;
+        
+        int count;
+        
+        // Particle attributes in separate arrays, padded to a multiple of four so kernels never need a tail loop
+        std::vector<float> positionX, positionY;
+        std::vector<float> velocityX, velocityY;
+        std::vector<float> age, inverseLifetime;
+        std::vector<float> size;
+        std::vector<SDL_Color> color;
+    };
+    
+    // Returns the emitter if the id refers to a live one
+    Emitter* findEmitter(int emitter);
+    
+    // Adds up to count particles at the emitter's position, as many as fit
+    void spawn(Emitter &emitter, int count);
+    
+    // Returns a random number in [0, 1), the generator is seeded the same way every run so replays spawn identically
+    float randomUnit();
+    
+    Kernel mKernel;
+    
+    std::vector<Emitter> mEmitters;
+    std::vector<int> mFreeEmitters;
+    
+    Uint32 mRandomState;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Vertices are rebuilt every render, the indices only ever grow when a larger emitter is created
+    std::vector<SDL_Vertex> mVertices;
+    std::vector<int> mIndices;
+#endif
+
+    int mLiveCount, mLastDrawnCount;
+};
+
+#endif /* particleSystem_hpp */
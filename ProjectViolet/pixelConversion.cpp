@@ -0,0 +1,392 @@
+//
+//  pixelConversion.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "pixelConversion.hpp"
+#include "profiler.hpp"
+
+#include <memory>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#define VIOLET_X86_KERNELS
+#endif
+
+namespace
+{
+    // Where each channel sits in a source and destination pixel, worked out once per image instead of per pixel
+    struct ConversionLayout
+    {
+        int bytesPerPixel;
+        
+        Uint32 redShift, greenShift, blueShift, alphaShift;
+        bool hasAlpha;
+        
+        Uint32 redOut, greenOut, blueOut;
+        
+        // Pixels whose color bits equal the key become transparent black
+        bool keyed;
+        Uint32 keyMask, keyValue;
+        
+        bool premultiply;
+    };
+    
+    typedef void (*RowKernel)(const Uint8 *source, Uint32 *destination, int width, const ConversionLayout &layout);
+    
+    PixelConversion::Kernel mKernel = PixelConversion::getBestKernel();
+    
+    bool mPremultiplyAlpha = false;
+    
+    // Reused by every upload so loading doesn't allocate a new buffer per image, main thread only
+    std::vector<Uint32> mStagingBuffer;
+    
+    // Exact division by 255 for the product of two bytes
+    inline Uint32 divide255(Uint32 value)
+    {
+        value += 128;
+        
+        return (value + (value >> 8)) >> 8;
+    }
+    
+    void convertRowScalar(const Uint8 *source, Uint32 *destination, int width, const ConversionLayout &layout)
+    {
+        for (int x = 0; x < width; x++, source += layout.bytesPerPixel)
+        {
+            Uint32 pixel;
+            
+            // 24 bit pixels are read the way SDL assembles them, which depends on the byte order
+            if (layout.bytesPerPixel == 4)
+                pixel = *reinterpret_cast<const Uint32*>(source);
+            else if (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+                pixel = source[0] | (source[1] << 8) | (source[2] << 16);
+            else
+                pixel = (source[0] << 16) | (source[1] << 8) | source[2];
+            
+            if (layout.keyed && (pixel & layout.keyMask) == layout.keyValue)
+            {
+                destination[x] = 0;
+                
+                continue;
+            }
+            
+            Uint32 red = (pixel >> layout.redShift) & 0xFF;
+            Uint32 green = (pixel >> layout.greenShift) & 0xFF;
+            Uint32 blue = (pixel >> layout.blueShift) & 0xFF;
+            Uint32 alpha = layout.hasAlpha ? (pixel >> layout.alphaShift) & 0xFF : 0xFF;
+            
+            if (layout.premultiply)
+            {
+                red = divide255(red * alpha);
+                green = divide255(green * alpha);
+                blue = divide255(blue * alpha);
+            }
+            
+            destination[x] = (alpha << 24) | (red << layout.redOut) | (green << layout.greenOut) | (blue << layout.blueOut);
+        }
+    }
+
+#ifdef VIOLET_X86_KERNELS
+    void convertRowSSE2(const Uint8 *source, Uint32 *destination, int width, const ConversionLayout &layout)
+    {
+        const __m128i channelMask = _mm_set1_epi32(0xFF);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+        const __m128i keyMask = _mm_set1_epi32(static_cast<int>(layout.keyMask));
+        const __m128i keyValue = _mm_set1_epi32(static_cast<int>(layout.keyValue));
+        const __m128i rounding = _mm_set1_epi16(128);
+        const __m128i zero = _mm_setzero_si128();
+        
+        // Shifts by a register apply the same count to every lane, which is all the channel moves need
+        const __m128i redShift = _mm_cvtsi32_si128(layout.redShift), redOut = _mm_cvtsi32_si128(layout.redOut);
+        const __m128i greenShift = _mm_cvtsi32_si128(layout.greenShift), greenOut = _mm_cvtsi32_si128(layout.greenOut);
+        const __m128i blueShift = _mm_cvtsi32_si128(layout.blueShift), blueOut = _mm_cvtsi32_si128(layout.blueOut);
+        const __m128i alphaShift = _mm_cvtsi32_si128(layout.alphaShift);
+        
+        int x = 0;
+        
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+            
+            __m128i result = _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(pixels, redShift), channelMask), redOut);
+            result = _mm_or_si128(result, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(pixels, greenShift), channelMask), greenOut));
+            result = _mm_or_si128(result, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(pixels, blueShift), channelMask), blueOut));
+            result = _mm_or_si128(result, layout.hasAlpha ? _mm_slli_epi32(_mm_srl_epi32(pixels, alphaShift), 24) : alphaMask);
+            
+            if (layout.premultiply)
+            {
+                // Widen to 16 bits per channel and multiply each channel by its pixel's alpha, the top lane of each pixel
+                __m128i low = _mm_unpacklo_epi8(result, zero);
+                __m128i high = _mm_unpackhi_epi8(result, zero);
+                
+                low = _mm_mullo_epi16(low, _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+                high = _mm_mullo_epi16(high, _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+                
+                low = _mm_add_epi16(low, rounding);
+                high = _mm_add_epi16(high, rounding);
+                
+                low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+                high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+                
+                // Alpha was multiplied by itself along with the colors, so the original is put back
+                result = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(low, high)), _mm_and_si128(result, alphaMask));
+            }
+            
+            if (layout.keyed)
+                result = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(pixels, keyMask), keyValue), result);
+            
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x), result);
+        }
+        
+        convertRowScalar(source + x * 4, destination + x, width - x, layout);
+    }
+    
+    __attribute__((target("avx2")))
+    void convertRowAVX2(const Uint8 *source, Uint32 *destination, int width, const ConversionLayout &layout)
+    {
+        const __m256i channelMask = _mm256_set1_epi32(0xFF);
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+        const __m256i keyMask = _mm256_set1_epi32(static_cast<int>(layout.keyMask));
+        const __m256i keyValue = _mm256_set1_epi32(static_cast<int>(layout.keyValue));
+        const __m256i rounding = _mm256_set1_epi16(128);
+        const __m256i zero = _mm256_setzero_si256();
+        
+        const __m128i redShift = _mm_cvtsi32_si128(layout.redShift), redOut = _mm_cvtsi32_si128(layout.redOut);
+        const __m128i greenShift = _mm_cvtsi32_si128(layout.greenShift), greenOut = _mm_cvtsi32_si128(layout.greenOut);
+        const __m128i blueShift = _mm_cvtsi32_si128(layout.blueShift), blueOut = _mm_cvtsi32_si128(layout.blueOut);
+        const __m128i alphaShift = _mm_cvtsi32_si128(layout.alphaShift);
+        
+        int x = 0;
+        
+        // Same steps as the SSE2 kernel on eight pixels, the unpacks and packs stay within each 128 bit half so they cancel out
+        for (; x + 8 <= width; x += 8)
+        {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + x * 4));
+            
+            __m256i result = _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(pixels, redShift), channelMask), redOut);
+            result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(pixels, greenShift), channelMask), greenOut));
+            result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_and_si256(_mm256_srl_epi32(pixels, blueShift), channelMask), blueOut));
+            result = _mm256_or_si256(result, layout.hasAlpha ? _mm256_slli_epi32(_mm256_srl_epi32(pixels, alphaShift), 24) : alphaMask);
+            
+            if (layout.premultiply)
+            {
+                __m256i low = _mm256_unpacklo_epi8(result, zero);
+                __m256i high = _mm256_unpackhi_epi8(result, zero);
+                
+                low = _mm256_mullo_epi16(low, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(low, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+                high = _mm256_mullo_epi16(high, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(high, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+                
+                low = _mm256_add_epi16(low, rounding);
+                high = _mm256_add_epi16(high, rounding);
+                
+                low = _mm256_srli_epi16(_mm256_add_epi16(low, _mm256_srli_epi16(low, 8)), 8);
+                high = _mm256_srli_epi16(_mm256_add_epi16(high, _mm256_srli_epi16(high, 8)), 8);
+                
+                result = _mm256_or_si256(_mm256_andnot_si256(alphaMask, _mm256_packus_epi16(low, high)), _mm256_and_si256(result, alphaMask));
+            }
+            
+            if (layout.keyed)
+                result = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(pixels, keyMask), keyValue), result);
+            
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + x), result);
+        }
+        
+        convertRowScalar(source + x * 4, destination + x, width - x, layout);
+    }
+#endif
+
+    RowKernel findRowKernel(PixelConversion::Kernel kernel)
+    {
+#ifdef VIOLET_X86_KERNELS
+        if (kernel == PixelConversion::Kernel::AVX2)
+            return convertRowAVX2;
+        
+        if (kernel == PixelConversion::Kernel::SSE2)
+            return convertRowSSE2;
+#endif
+
+        return convertRowScalar;
+    }
+}
+
+namespace PixelConversion
+{
+    Kernel getBestKernel()
+    {
+#ifdef VIOLET_X86_KERNELS
+        if (SDL_HasAVX2())
+            return Kernel::AVX2;
+        
+        if (SDL_HasSSE2())
+            return Kernel::SSE2;
+#endif
+
+        return Kernel::Scalar;
+    }
+    
+    void setKernel(Kernel kernel)
+    {
+        Kernel bestKernel = getBestKernel();
+        
+        mKernel = kernel > bestKernel ? bestKernel : kernel;
+    }
+    
+    Kernel getKernel()
+    {
+        return mKernel;
+    }
+    
+    const char* getKernelName(Kernel kernel)
+    {
+        switch (kernel)
+        {
+            case Kernel::AVX2:
+                return "avx2";
+            
+            case Kernel::SSE2:
+                return "sse2";
+            
+            default:
+                return "scalar";
+        }
+    }
+    
+    bool isSupportedDestination(Uint32 pixelFormat)
+    {
+        return pixelFormat == SDL_PIXELFORMAT_ARGB8888 || pixelFormat == SDL_PIXELFORMAT_ABGR8888;
+    }
+    
+    bool canConvert(SDL_Surface *surface)
+    {
+        const SDL_PixelFormat *format = surface->format;
+        
+        if (format->palette != nullptr || (format->BytesPerPixel != 3 && format->BytesPerPixel != 4))
+            return false;
+        
+        // Every channel has to be a whole byte, the kernels don't scale channels up
+        return format->Rloss == 0 && format->Gloss == 0 && format->Bloss == 0 && (format->Amask == 0 || format->Aloss == 0);
+    }
+    
+    Uint32 findNativeFormat(SDL_Renderer *renderer)
+    {
+        SDL_RendererInfo info;
+        
+        if (SDL_GetRendererInfo(renderer, &info) == 0)
+        {
+            // Renderers list their formats best first
+            for (Uint32 i = 0; i < info.num_texture_formats; i++)
+            {
+                if (isSupportedDestination(info.texture_formats[i]))
+                    return info.texture_formats[i];
+            }
+        }
+        
+        return SDL_PIXELFORMAT_ARGB8888;
+    }
+    
+    bool convert(SDL_Surface *surface, Uint32 destinationFormat, bool premultiply, void *destination, int destinationPitch)
+    {
+        PROFILE_ZONE("PixelConversion::convert")
+        
+        if (!canConvert(surface) || !isSupportedDestination(destinationFormat))
+            return false;
+        
+        const SDL_PixelFormat *format = surface->format;
+        
+        ConversionLayout layout;
+        layout.bytesPerPixel = format->BytesPerPixel;
+        layout.redShift = format->Rshift;
+        layout.greenShift = format->Gshift;
+        layout.blueShift = format->Bshift;
+        layout.alphaShift = format->Ashift;
+        layout.hasAlpha = format->Amask != 0;
+        layout.redOut = destinationFormat == SDL_PIXELFORMAT_ARGB8888 ? 16 : 0;
+        layout.greenOut = 8;
+        layout.blueOut = destinationFormat == SDL_PIXELFORMAT_ARGB8888 ? 0 : 16;
+        layout.keyMask = format->Rmask | format->Gmask | format->Bmask;
+        layout.keyValue = 0;
+        layout.keyed = SDL_GetColorKey(surface, &layout.keyValue) == 0;
+        layout.keyValue &= layout.keyMask;
+        layout.premultiply = premultiply;
+        
+        // The vector kernels only read whole 32 bit pixels
+        RowKernel rowKernel = layout.bytesPerPixel == 4 ? findRowKernel(mKernel) : convertRowScalar;
+        
+        const Uint8 *sourceRow = static_cast<const Uint8*>(surface->pixels);
+        Uint8 *destinationRow = static_cast<Uint8*>(destination);
+        
+        for (int y = 0; y < surface->h; y++, sourceRow += surface->pitch, destinationRow += destinationPitch)
+            rowKernel(sourceRow, reinterpret_cast<Uint32*>(destinationRow), surface->w, layout);
+        
+        return true;
+    }
+    
+    SDL_Texture* createTexture(SDL_Renderer *renderer, SDL_Surface *surface, Uint32 pixelFormat)
+    {
+        PROFILE_ZONE("PixelConversion::createTexture")
+        
+        if (!canConvert(surface))
+            return SDL_CreateTextureFromSurface(renderer, surface);
+        
+        Uint32 destinationFormat = isSupportedDestination(pixelFormat) ? pixelFormat : findNativeFormat(renderer);
+        
+        // The staging buffer only ever grows, so it settles at the size of the largest image
+        size_t pixelCount = static_cast<size_t>(surface->w) * surface->h;
+        
+        if (mStagingBuffer.size() < pixelCount)
+            mStagingBuffer.resize(pixelCount);
+        
+        if (!convert(surface, destinationFormat, mPremultiplyAlpha, mStagingBuffer.data(), surface->w * 4))
+            return SDL_CreateTextureFromSurface(renderer, surface);
+        
+        SDL_Texture *texture = SDL_CreateTexture(renderer, destinationFormat, SDL_TEXTUREACCESS_STATIC, surface->w, surface->h);
+        
+        if (texture == nullptr)
+            return nullptr;
+        
+        if (SDL_UpdateTexture(texture, nullptr, mStagingBuffer.data(), surface->w * 4) != 0)
+        {
+            SDL_DestroyTexture(texture);
+            
+            return nullptr;
+        }
+        
+        // Blend the same way SDL_CreateTextureFromSurface would have, only images with transparency need it
+        Uint32 colorKey;
+        
+        if (surface->format->Amask != 0 || SDL_GetColorKey(surface, &colorKey) == 0)
+            SDL_SetTextureBlendMode(texture, mPremultiplyAlpha ? getPremultipliedBlendMode() : SDL_BLENDMODE_BLEND);
+        
+        return texture;
+    }
+    
+    void setPremultiplyAlpha(bool premultiply)
+    {
+        mPremultiplyAlpha = premultiply;
+    }
+    
+    bool isPremultiplyingAlpha()
+    {
+        return mPremultiplyAlpha;
+    }
+    
+    SDL_BlendMode getPremultipliedBlendMode()
+    {
+        static SDL_BlendMode premultipliedBlendMode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        
+        return premultipliedBlendMode;
+    }
+    
+    bool supportsPremultipliedBlendMode(SDL_Renderer *renderer)
+    {
+        // Custom blend modes are only refused when they are set on a texture, so try it on a throwaway one
+        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1), SDL_DestroyTexture);
+        
+        return texture && SDL_SetTextureBlendMode(texture.get(), getPremultipliedBlendMode()) == 0;
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  pixelConversion.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef pixelConversion_hpp
+#define pixelConversion_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+
+// Converts decoded images to the renderer's texture format in one pass, so SDL doesn't convert them again on upload
+namespace PixelConversion
+{
+    // Kernels from slowest to fastest, a kernel is only used if the CPU supports it
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+    
+    // Returns the fastest kernel this CPU supports
+    Kernel getBestKernel();
+    
+    // Forces a kernel for all following conversions, unsupported kernels fall back to the best supported one
+    void setKernel(Kernel kernel);
+    
+    // Returns the kernel conversions currently use
+    Kernel getKernel();
+    
+    // Returns the kernel's name for logs and benchmark results
+    const char* getKernelName(Kernel kernel);
+    
+    // Returns true if the kernels can write the format, currently the 32 bit formats with alpha in the top byte
+    bool isSupportedDestination(Uint32 pixelFormat);
+    
+    // Returns true if the kernels can read the surface, 24 and 32 bit formats with 8 bit channels
+    bool canConvert(SDL_Surface *surface);
+    
+    // Returns the first format the renderer supports natively that the kernels can write
+    Uint32 findNativeFormat(SDL_Renderer *renderer);
+    
+    // Converts the surface into the destination format, the surface's color key becomes transparent black and alpha
+    // is premultiplied if requested, returns false if the formats aren't supported
+    bool convert(SDL_Surface *surface, Uint32 destinationFormat, bool premultiply, void *destination, int destinationPitch);
+    
+    // Creates a static texture from the surface by converting it into a reusable staging buffer and uploading that
+    // with SDL_UpdateTexture, falls back to SDL_CreateTextureFromSurface for formats the kernels can't read, main thread only
+    SDL_Texture* createTexture(SDL_Renderer *renderer, SDL_Surface *surface, Uint32 pixelFormat);
+    
+    // Makes createTexture premultiply alpha and give its textures the premultiplied blend mode
+    void setPremultiplyAlpha(bool premultiply);
+    
+    // Returns true if createTexture premultiplies alpha
+    bool isPremultiplyingAlpha();
+    
+    // Returns the blend mode premultiplied textures must be drawn with, alpha modulation alone won't fade them,
+    // the color modulation has to be scaled by the same amount
+    SDL_BlendMode getPremultipliedBlendMode();
+    
+    // Returns true if the renderer can draw with the premultiplied blend mode, the software renderer can't
+    bool supportsPremultipliedBlendMode(SDL_Renderer *renderer);
+}
+
+#endif /* pixelConversion_hpp */
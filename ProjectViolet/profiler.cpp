@@ -0,0 +1,233 @@
+//
+//  profiler.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "profiler.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    enum ProfilerEventType : Uint8
+    {
+        ZoneBegin,
+        ZoneEnd,
+        Counter
+    };
+    
+    // Kept small and trivially copyable so recording is a handful of stores
+    struct ProfilerEvent
+    {
+        Uint64 timestamp;
+        const char *name;
+        double value;
+        ProfilerEventType type;
+    };
+    
+    // One writer (the owning thread), only read once the capture has ended
+    struct ThreadEventBuffer
+    {
+        std::unique_ptr<ProfilerEvent[]> events;
+        std::atomic<Uint64> writeCount;
+        Uint64 captureId;
+        int threadId;
+    };
+    
+    std::atomic<bool> mCapturing(false);
+    
+    // Bumped by every capture so stale buffers can be detected without touching other threads
+    std::atomic<Uint64> mCaptureId(0);
+    
+    Uint64 mCaptureStart = 0;
+    
+    // Every thread's buffer, registered on the thread's first event
+    std::mutex mBufferListMutex;
+    std::vector<std::shared_ptr<ThreadEventBuffer>> mThreadBuffers;
+    
+    ThreadEventBuffer& findThreadBuffer()
+    {
+        thread_local std::shared_ptr<ThreadEventBuffer> threadBuffer;
+        
+        if (!threadBuffer)
+        {
+            threadBuffer = std::make_shared<ThreadEventBuffer>();
+            threadBuffer->events.reset(new ProfilerEvent[Profiler::EVENTS_PER_THREAD]);
+            threadBuffer->writeCount = 0;
+            threadBuffer->captureId = mCaptureId.load(std::memory_order_acquire);
+            
+            std::lock_guard<std::mutex> lock(mBufferListMutex);
+            
+            threadBuffer->threadId = static_cast<int>(mThreadBuffers.size()) + 1;
+            mThreadBuffers.push_back(threadBuffer);
+        }
+        
+        // A new capture started since this thread last recorded, so start the ring over
+        Uint64 captureId = mCaptureId.load(std::memory_order_acquire);
+        
+        if (threadBuffer->captureId != captureId)
+        {
+            threadBuffer->captureId = captureId;
+            threadBuffer->writeCount.store(0, std::memory_order_relaxed);
+        }
+        
+        return *threadBuffer;
+    }
+    
+    void recordEvent(ProfilerEventType type, const char *name, double value)
+    {
+        if (!mCapturing.load(std::memory_order_relaxed))
+            return;
+        
+        ThreadEventBuffer &buffer = findThreadBuffer();
+        
+        Uint64 index = buffer.writeCount.load(std::memory_order_relaxed);
+        
+        buffer.events[index & (Profiler::EVENTS_PER_THREAD - 1)] = {SDL_GetPerformanceCounter(), name, value, type};
+        buffer.writeCount.store(index + 1, std::memory_order_release);
+    }
+    
+    // Writes a string with the characters JSON can't hold raw escaped
+    void writeJSONString(std::ofstream &output, const char *text)
+    {
+        output << '"';
+        
+        for (; *text != '\0'; text++)
+        {
+            if (*text == '"' || *text == '\\')
+                output << '\\' << *text;
+            else if (static_cast<unsigned char>(*text) >= 0x20)
+                output << *text;
+        }
+        
+        output << '"';
+    }
+}
+
+namespace Profiler
+{
+    void beginCapture()
+    {
+        mCaptureStart = SDL_GetPerformanceCounter();
+        
+        mCaptureId.fetch_add(1, std::memory_order_acq_rel);
+        mCapturing.store(true, std::memory_order_release);
+    }
+    
+    bool isCapturing()
+    {
+        return mCapturing.load(std::memory_order_relaxed);
+    }
+    
+    void beginZone(const char *name)
+    {
+        recordEvent(ZoneBegin, name, 0.0);
+    }
+    
+    void endZone(const char *name)
+    {
+        recordEvent(ZoneEnd, name, 0.0);
+    }
+    
+    void recordCounter(const char *name, double value)
+    {
+        recordEvent(Counter, name, value);
+    }
+    
+    bool endCapture(std::string filePath)
+    {
+        mCapturing.store(false, std::memory_order_release);
+        
+        std::ofstream output(filePath, std::ofstream::out | std::ofstream::trunc);
+        
+        if (!output)
+        {
+            LOG_MESSAGE(Error, "Failed to open %s for the profiler capture!", filePath.c_str())
+            
+            return false;
+        }
+        
+        // Chrome trace timestamps are in microseconds, written to the nanosecond rather than to six significant
+        // digits, which past a second into the capture would round zones together
+        output << std::fixed << std::setprecision(3);
+        
+        const double ticksToMicroseconds = 1000000.0 / SDL_GetPerformanceFrequency();
+        const Uint64 captureId = mCaptureId.load(std::memory_order_acquire);
+        
+        bool firstEvent = true;
+        
+        output << "{\"traceEvents\":[\n";
+        
+        std::lock_guard<std::mutex> lock(mBufferListMutex);
+        
+        for (std::shared_ptr<ThreadEventBuffer> &buffer : mThreadBuffers)
+        {
+            // Threads that recorded nothing during this capture still hold the last capture's events
+            if (buffer->captureId != captureId)
+                continue;
+            
+            Uint64 writeCount = buffer->writeCount.load(std::memory_order_acquire);
+            Uint64 firstIndex = writeCount > static_cast<Uint64>(EVENTS_PER_THREAD) ? writeCount - EVENTS_PER_THREAD : 0;
+            
+            // Zones nest on a thread, so an end with no begin still open lost its begin to the ring wrapping
+            int openZones = 0;
+            
+            for (Uint64 index = firstIndex; index < writeCount; index++)
+            {
+                const ProfilerEvent &event = buffer->events[index & (EVENTS_PER_THREAD - 1)];
+                
+                // The ring may have wrapped over the start of a zone, so skip events from before the capture
+                if (event.timestamp < mCaptureStart)
+                    continue;
+                
+                if (event.type == ZoneBegin)
+                    openZones++;
+                
+                if (event.type == ZoneEnd)
+                {
+                    if (openZones == 0)
+                        continue;
+                    
+                    openZones--;
+                }
+                
+                if (!firstEvent)
+                    output << ",\n";
+                
+                firstEvent = false;
+                
+                output << "{\"name\":";
+                writeJSONString(output, event.name);
+                output << ",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":" << (event.timestamp - mCaptureStart) * ticksToMicroseconds;
+                
+                switch (event.type)
+                {
+                    case ZoneBegin:
+                        output << ",\"ph\":\"B\"}";
+                        break;
+                    
+                    case ZoneEnd:
+                        output << ",\"ph\":\"E\"}";
+                        break;
+                    
+                    case Counter:
+                        output << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+                        break;
+                }
+            }
+        }
+        
+        output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        
+        return static_cast<bool>(output);
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  profiler.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef profiler_hpp
+#define profiler_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+
+// Zones and counters only exist in debug builds, just like ON_DEBUG
+#ifndef NDEBUG
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) Profiler::ScopedZone PROFILER_CONCAT(profilerZone, __LINE__)(name);
+#define PROFILE_COUNTER(name, value) Profiler::recordCounter(name, static_cast<double>(value));
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_COUNTER(name, value)
+#endif
+
+namespace Profiler
+{
+    // Number of events each thread's ring buffer holds before the oldest are overwritten
+    const int EVENTS_PER_THREAD = 1 << 16;
+    
+    // Starts recording zones and counters, dropping anything recorded before
+    void beginCapture();
+    
+    // Stops recording and writes the capture as Chrome trace_event JSON, viewable in Perfetto, every other thread that
+    // records events must have stopped first since their rings are read without locking
+    bool endCapture(std::string filePath);
+    
+    // Returns whether a capture is running
+    bool isCapturing();
+    
+    // Records the start of a zone, name must outlive the capture (a string literal)
+    void beginZone(const char *name);
+    
+    // Records the end of the innermost open zone
+    void endZone(const char *name);
+    
+    // Records a named counter value
+    void recordCounter(const char *name, double value);
+    
+    // Begins a zone on construction and ends it on destruction
+    class ScopedZone
+    {
+    public:
+        ScopedZone(const char *name) : mName(name)
+        {
+            beginZone(mName);
+        }
+        
+        ~ScopedZone()
+        {
+            endZone(mName);
+        }
+    
+    private:
+        const char *mName;
+    };
+}
+
+#endif /* profiler_hpp */
@@ -0,0 +1,218 @@
+//
+//  renderQueue.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "frameArena.hpp"
+#include "profiler.hpp"
+#include "renderQueue.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    bool isSameCommand(const DrawCommand &first, const DrawCommand &second)
+    {
+        return first.texture == second.texture && first.layer == second.layer && first.blendMode == second.blendMode && first.flip == second.flip && first.angle == second.angle
+            && first.hasCenter == second.hasCenter && (!first.hasCenter || (first.center.x == second.center.x && first.center.y == second.center.y))
+            && first.source.x == second.source.x && first.source.y == second.source.y && first.source.w == second.source.w && first.source.h == second.source.h
+            && first.destination.x == second.destination.x && first.destination.y == second.destination.y && first.destination.w == second.destination.w && first.destination.h == second.destination.h
+            && first.colorModulation.r == second.colorModulation.r && first.colorModulation.g == second.colorModulation.g && first.colorModulation.b == second.colorModulation.b && first.colorModulation.a == second.colorModulation.a;
+    }
+}
+
+RenderQueue::RenderQueue() : mLastCommandCount(0), mLastTextureSwitchCount(0), mLastStateChangeCount(0)
+{
+    
+}
+
+void RenderQueue::clear()
+{
+    mCommands.clear();
+}
+
+void RenderQueue::submit(const DrawCommand &command)
+{
+    if (command.texture == nullptr)
+        return;
+    
+    mCommands.push_back(command);
+}
+
+SDL_Rect RenderQueue::findCoveredArea(const DrawCommand &command)
+{
+    if (command.angle == 0.0)
+        return command.destination;
+    
+    // Rotating about the pivot keeps every corner at the same distance from it, so the farthest corner bounds the quad
+    const SDL_Rect &destination = command.destination;
+    
+    int pivotX = command.hasCenter ? command.center.x : destination.w / 2;
+    int pivotY = command.hasCenter ? command.center.y : destination.h / 2;
+    
+    int farthestX = std::max(pivotX, destination.w - pivotX);
+    int farthestY = std::max(pivotY, destination.h - pivotY);
+    
+    int radius = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(farthestX) * farthestX + static_cast<double>(farthestY) * farthestY)));
+    
+    return {destination.x + pivotX - radius, destination.y + pivotY - radius, radius * 2, radius * 2};
+}
+
+void RenderQueue::collectChanges(DirtyRegions &dirtyRegions)
+{
+    PROFILE_ZONE("RenderQueue::collectChanges")
+    
+    // Commands are compared by submission order, which stays the same for a scene that didn't change
+    if (!dirtyRegions.isFullyDirty())
+    {
+        size_t commonCount = std::min(mCommands.size(), mPreviousCommands.size());
+        
+        for (size_t i = 0; i < commonCount; i++)
+        {
+            if (isSameCommand(mCommands[i], mPreviousCommands[i]))
+                continue;
+            
+            // Both where the quad was and where it is now have to be drawn again
+            dirtyRegions.mark(findCoveredArea(mPreviousCommands[i]));
+            dirtyRegions.mark(findCoveredArea(mCommands[i]));
+        }
+        
+        for (size_t i = commonCount; i < mCommands.size(); i++)
+            dirtyRegions.mark(findCoveredArea(mCommands[i]));
+        
+        for (size_t i = commonCount; i < mPreviousCommands.size(); i++)
+            dirtyRegions.mark(findCoveredArea(mPreviousCommands[i]));
+    }
+    
+    mPreviousCommands.assign(mCommands.begin(), mCommands.end());
+}
+
+void RenderQueue::flush(std::shared_ptr<SDL_Renderer> &renderer, const std::vector<SDL_Rect> *regions)
+{
+    PROFILE_ZONE("RenderQueue::flush")
+    
+    mLastCommandCount = 0;
+    mLastTextureSwitchCount = 0;
+    mLastStateChangeCount = 0;
+    
+    // The order only lives for this flush, so it comes from the frame arena
+    Uint32 *drawOrder = FrameMemory::getArena().allocateArray<Uint32>(mCommands.size());
+    Uint32 *drawOrderEnd = drawOrder + mCommands.size();
+    
+    for (Uint32 index = 0; index < mCommands.size(); index++)
+        drawOrder[index] = index;
+    
+    // Sorting the indices instead of the commands keeps the swaps small, and the submission index
+    // as the last key keeps same-state commands in the order they were recorded
+    std::sort(drawOrder, drawOrderEnd, [this](Uint32 a, Uint32 b)
+    {
+        const DrawCommand &first = mCommands[a];
+        const DrawCommand &second = mCommands[b];
+        
+        if (first.layer != second.layer)
+            return first.layer < second.layer;
+        
+        if (first.blendMode != second.blendMode)
+            return first.blendMode < second.blendMode;
+        
+        if (first.texture != second.texture)
+            return first.texture < second.texture;
+        
+        return a < b;
+    });
+    
+    if (regions == nullptr)
+    {
+        draw(renderer.get(), drawOrder, drawOrderEnd, nullptr);
+    }
+    else
+    {
+        // Each region is drawn in full sorted order on its own, so overlapping quads still layer correctly
+        for (const SDL_Rect &region : *regions)
+        {
+            SDL_RenderSetClipRect(renderer.get(), &region);
+            
+            draw(renderer.get(), drawOrder, drawOrderEnd, &region);
+        }
+        
+        SDL_RenderSetClipRect(renderer.get(), nullptr);
+    }
+    
+    PROFILE_COUNTER("Render queue commands", mLastCommandCount)
+    PROFILE_COUNTER("Render queue texture switches", mLastTextureSwitchCount)
+    
+    clear();
+}
+
+void RenderQueue::draw(SDL_Renderer *renderer, const Uint32 *drawOrder, const Uint32 *drawOrderEnd, const SDL_Rect *region)
+{
+    SDL_Texture *currentTexture = nullptr;
+    SDL_Color currentColor {0, 0, 0, 0};
+    SDL_BlendMode currentBlendMode = SDL_BLENDMODE_INVALID;
+    
+    for (const Uint32 *index = drawOrder; index != drawOrderEnd; index++)
+    {
+        const DrawCommand &command = mCommands[*index];
+        
+        if (region != nullptr)
+        {
+            SDL_Rect coveredArea = findCoveredArea(command);
+            
+            if (!SDL_HasIntersection(&coveredArea, region))
+                continue;
+        }
+        
+        mLastCommandCount++;
+        
+        // The texture's previous state is unknown after a switch, so every setting is applied once
+        bool textureChanged = command.texture != currentTexture;
+        
+        if (textureChanged)
+        {
+            currentTexture = command.texture;
+            mLastTextureSwitchCount++;
+        }
+        
+        if (textureChanged || command.blendMode != currentBlendMode)
+        {
+            currentBlendMode = command.blendMode;
+            SDL_SetTextureBlendMode(currentTexture, currentBlendMode);
+            mLastStateChangeCount++;
+        }
+        
+        if (textureChanged || command.colorModulation.r != currentColor.r || command.colorModulation.g != currentColor.g || command.colorModulation.b != currentColor.b)
+        {
+            SDL_SetTextureColorMod(currentTexture, command.colorModulation.r, command.colorModulation.g, command.colorModulation.b);
+            mLastStateChangeCount++;
+        }
+        
+        if (textureChanged || command.colorModulation.a != currentColor.a)
+        {
+            SDL_SetTextureAlphaMod(currentTexture, command.colorModulation.a);
+            mLastStateChangeCount++;
+        }
+        
+        currentColor = command.colorModulation;
+        
+        SDL_RenderCopyEx(renderer, command.texture, &command.source, &command.destination, command.angle, command.hasCenter ? &command.center : nullptr, command.flip);
+    }
+}
+
+int RenderQueue::getLastCommandCount()
+{
+    return mLastCommandCount;
+}
+
+int RenderQueue::getLastTextureSwitchCount()
+{
+    return mLastTextureSwitchCount;
+}
+
+int RenderQueue::getLastStateChangeCount()
+{
+    return mLastStateChangeCount;
+}
@@ -0,0 +1,88 @@
+//
+//  renderQueue.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef renderQueue_hpp
+#define renderQueue_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+#include "dirtyRegions.hpp"
+
+// Everything needed to draw one textured quad, held by value so recording a draw never allocates
+struct DrawCommand
+{
+    SDL_Texture *texture;
+    
+    // Part of the texture shown, and where it lands on screen
+    SDL_Rect source;
+    SDL_Rect destination;
+    
+    // Rotation in degrees about center, or about the destination's middle when hasCenter is false
+    double angle;
+    SDL_Point center;
+    bool hasCenter;
+    
+    SDL_RendererFlip flip;
+    
+    SDL_Color colorModulation;
+    SDL_BlendMode blendMode;
+    
+    // Lower layers are drawn first, order within a layer is only kept for commands sharing texture and blend state
+    int layer;
+};
+
+// Records a frame's draw commands and submits them sorted by layer, blend mode and texture
+class RenderQueue
+{
+public:
+    // Initializes an empty queue
+    RenderQueue();
+    
+    // Forgets the recorded commands while keeping their storage
+    void clear();
+    
+    // Records a command for the next flush
+    void submit(const DrawCommand &command);
+    
+    // Marks where the recorded commands differ from the ones recorded last time this was called, so an unchanged
+    // scene marks nothing
+    void collectChanges(DirtyRegions &dirtyRegions);
+    
+    // Sorts and draws every recorded command, then clears the queue, with regions only the commands overlapping each
+    // region are drawn, clipped to it
+    void flush(std::shared_ptr<SDL_Renderer> &renderer, const std::vector<SDL_Rect> *regions = nullptr);
+    
+    // Returns the number of commands drawn by the last flush
+    int getLastCommandCount();
+    
+    // Returns how many times the last flush had to switch textures
+    int getLastTextureSwitchCount();
+    
+    // Returns how many texture color, alpha or blend changes the last flush made
+    int getLastStateChangeCount();
+
+private:
+    // Returns the part of the screen a command can touch, rotated commands can reach past their destination
+    static SDL_Rect findCoveredArea(const DrawCommand &command);
+    
+    // Draws the commands in the given order, skipping those outside the region if there is one
+    void draw(SDL_Renderer *renderer, const Uint32 *drawOrder, const Uint32 *drawOrderEnd, const SDL_Rect *region);
+    
+    // Commands are stored in submission order, flush() sorts an index array from the frame arena to draw them
+    std::vector<DrawCommand> mCommands;
+    
+    // The commands seen by the last collectChanges(), storage is reused so comparing never allocates once warmed up
+    std::vector<DrawCommand> mPreviousCommands;
+    
+    int mLastCommandCount, mLastTextureSwitchCount, mLastStateChangeCount;
+};
+
+#endif /* renderQueue_hpp */
@@ -0,0 +1,347 @@
+//
+//  saveState.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "profiler.hpp"
+#include "saveState.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <zlib.h>
+
+namespace
+{
+    // Components are saved as raw bytes, so they must stay plain data
+    static_assert(std::is_trivially_copyable<Entity>::value && std::is_trivially_copyable<Transform>::value && std::is_trivially_copyable<Velocity>::value, "Saved components must be trivially copyable");
+    
+    // Written in front of the compressed payload
+    struct SaveHeader
+    {
+        Uint32 magic;
+        Uint32 version;
+        Uint64 payloadSize;
+        Uint64 compressedSize;
+    };
+    
+    // Start of the payload, the sizes catch saves made with a different component layout
+    struct PayloadHeader
+    {
+        Uint32 entityCount;
+        Uint32 transformCount;
+        Uint32 velocityCount;
+        Uint32 entitySize;
+        Uint32 transformSize;
+        Uint32 velocitySize;
+    };
+    
+    template <typename Value>
+    void appendArray(std::vector<Uint8> &payload, const std::vector<Value> &values)
+    {
+        const Uint8 *bytes = reinterpret_cast<const Uint8*>(values.data());
+        
+        payload.insert(payload.end(), bytes, bytes + values.size() * sizeof(Value));
+    }
+    
+    // Copies count values out of the payload, returns false if it runs short
+    template <typename Value>
+    bool readArray(const std::vector<Uint8> &payload, size_t &offset, Uint32 count, std::vector<Value> &values)
+    {
+        size_t byteCount = static_cast<size_t>(count) * sizeof(Value);
+        
+        if (offset + byteCount > payload.size())
+            return false;
+        
+        values.resize(count);
+        std::memcpy(values.data(), payload.data() + offset, byteCount);
+        
+        offset += byteCount;
+        
+        return true;
+    }
+}
+
+namespace SaveState
+{
+    void captureSnapshot(EntityRegistry &registry, WorldSnapshot &snapshot)
+    {
+        PROFILE_ZONE("SaveState::captureSnapshot")
+        
+        // Dense arrays copy straight across, and assign() reuses the snapshot's capacity
+        ComponentPool<Transform> &transforms = registry.pool<Transform>();
+        ComponentPool<Velocity> &velocities = registry.pool<Velocity>();
+        
+        registry.getAliveEntities(snapshot.entities);
+        
+        snapshot.transformEntities.assign(transforms.entities().begin(), transforms.entities().end());
+        snapshot.transforms.assign(transforms.components().begin(), transforms.components().end());
+        
+        snapshot.velocityEntities.assign(velocities.entities().begin(), velocities.entities().end());
+        snapshot.velocities.assign(velocities.components().begin(), velocities.components().end());
+    }
+    
+    bool restoreSnapshot(WorldSnapshot &snapshot, EntityRegistry &registry)
+    {
+        PROFILE_ZONE("SaveState::restoreSnapshot")
+        
+        registry.restoreEntities(snapshot.entities);
+        
+        // Every component owner should have been recreated above, anything left over means the save is inconsistent
+        size_t orphanCount = 0;
+        
+        for (size_t i = 0; i < snapshot.transformEntities.size(); i++)
+        {
+            if (registry.isAlive(snapshot.transformEntities[i]))
+                registry.emplace<Transform>(snapshot.transformEntities[i], snapshot.transforms[i]);
+            else
+                orphanCount++;
+        }
+        
+        for (size_t i = 0; i < snapshot.velocityEntities.size(); i++)
+        {
+            if (registry.isAlive(snapshot.velocityEntities[i]))
+                registry.emplace<Velocity>(snapshot.velocityEntities[i], snapshot.velocities[i]);
+            else
+                orphanCount++;
+        }
+        
+        if (orphanCount > 0)
+        {
+            LOG_MESSAGE(Warning, "The save had %zu components for entities it doesn't list, they were not restored!", orphanCount)
+            
+            return false;
+        }
+        
+        return true;
+    }
+    
+    bool writeSnapshot(WorldSnapshot &snapshot, std::string filePath)
+    {
+        PROFILE_ZONE("SaveState::writeSnapshot")
+        
+        PayloadHeader payloadHeader = {static_cast<Uint32>(snapshot.entities.size()), static_cast<Uint32>(snapshot.transforms.size()), static_cast<Uint32>(snapshot.velocities.size()), sizeof(Entity), sizeof(Transform), sizeof(Velocity)};
+        
+        std::vector<Uint8> payload;
+        payload.reserve(sizeof(payloadHeader) + snapshot.entities.size() * sizeof(Entity) + snapshot.transforms.size() * (sizeof(Entity) + sizeof(Transform)) + snapshot.velocities.size() * (sizeof(Entity) + sizeof(Velocity)));
+        
+        const Uint8 *headerBytes = reinterpret_cast<const Uint8*>(&payloadHeader);
+        payload.insert(payload.end(), headerBytes, headerBytes + sizeof(payloadHeader));
+        
+        appendArray(payload, snapshot.entities);
+        appendArray(payload, snapshot.transformEntities);
+        appendArray(payload, snapshot.transforms);
+        appendArray(payload, snapshot.velocityEntities);
+        appendArray(payload, snapshot.velocities);
+        
+        // Saves are written often, so favour speed over size
+        uLongf compressedSize = compressBound(static_cast<uLong>(payload.size()));
+        std::vector<Uint8> compressed(compressedSize);
+        
+        if (compress2(compressed.data(), &compressedSize, payload.data(), static_cast<uLong>(payload.size()), Z_BEST_SPEED) != Z_OK)
+        {
+            LOG_MESSAGE(Error, "Failed to compress the save for %s!", filePath.c_str())
+            
+            return false;
+        }
+        
+        SaveHeader header = {SAVE_MAGIC, SAVE_VERSION, payload.size(), compressedSize};
+        
+        // Written next to the real file and renamed over it, so a crash mid-save never corrupts the last good save
+        std::string temporaryPath = filePath + ".tmp";
+        
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressedSize));
+            
+            if (!file)
+            {
+                LOG_MESSAGE(Error, "Failed to write the save file %s!", temporaryPath.c_str())
+                
+                return false;
+            }
+        }
+        
+        if (std::rename(temporaryPath.c_str(), filePath.c_str()) != 0)
+        {
+            LOG_MESSAGE(Error, "Failed to replace the save file %s!", filePath.c_str())
+            
+            return false;
+        }
+        
+        return true;
+    }
+    
+    bool readSnapshot(std::string filePath, WorldSnapshot &snapshot)
+    {
+        PROFILE_ZONE("SaveState::readSnapshot")
+        
+        std::ifstream file(filePath, std::ios::binary);
+        
+        SaveHeader header;
+        
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != SAVE_MAGIC)
+        {
+            LOG_MESSAGE(Error, "%s is not a save file!", filePath.c_str())
+            
+            return false;
+        }
+        
+        if (header.version != SAVE_VERSION)
+        {
+            LOG_MESSAGE(Error, "%s is a version %u save, only version %u can be loaded!", filePath.c_str(), header.version, SAVE_VERSION)
+            
+            return false;
+        }
+        
+        std::vector<Uint8> compressed(static_cast<size_t>(header.compressedSize));
+        std::vector<Uint8> payload(static_cast<size_t>(header.payloadSize));
+        
+        uLongf payloadSize = static_cast<uLongf>(header.payloadSize);
+        
+        if (!file.read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(compressed.size())) ||
+            uncompress(payload.data(), &payloadSize, compressed.data(), static_cast<uLong>(compressed.size())) != Z_OK || payloadSize != header.payloadSize || payload.size() < sizeof(PayloadHeader))
+        {
+            LOG_MESSAGE(Error, "The save file %s is damaged!", filePath.c_str())
+            
+            return false;
+        }
+        
+        PayloadHeader payloadHeader;
+        std::memcpy(&payloadHeader, payload.data(), sizeof(payloadHeader));
+        
+        if (payloadHeader.entitySize != sizeof(Entity) || payloadHeader.transformSize != sizeof(Transform) || payloadHeader.velocitySize != sizeof(Velocity))
+        {
+            LOG_MESSAGE(Error, "%s was saved with a different component layout!", filePath.c_str())
+            
+            return false;
+        }
+        
+        // Each array is one allocation and one copy
+        size_t offset = sizeof(payloadHeader);
+        
+        bool complete = readArray(payload, offset, payloadHeader.entityCount, snapshot.entities) &&
+                        readArray(payload, offset, payloadHeader.transformCount, snapshot.transformEntities) &&
+                        readArray(payload, offset, payloadHeader.transformCount, snapshot.transforms) &&
+                        readArray(payload, offset, payloadHeader.velocityCount, snapshot.velocityEntities) &&
+                        readArray(payload, offset, payloadHeader.velocityCount, snapshot.velocities);
+        
+        if (!complete)
+        {
+            LOG_MESSAGE(Error, "The save file %s is truncated!", filePath.c_str())
+            
+            return false;
+        }
+        
+        return true;
+    }
+}
+
+SnapshotWriter::SnapshotWriter() : mSavePending(false), mLastSaveSucceeded(true), mRunning(false)
+{
+    
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    stop();
+}
+
+void SnapshotWriter::start()
+{
+    if (mRunning)
+        return;
+    
+    mRunning = true;
+    mWriterThread = std::thread(&SnapshotWriter::writerLoop, this);
+}
+
+void SnapshotWriter::stop()
+{
+    if (!mWriterThread.joinable())
+        return;
+    
+    {
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        
+        mRunning = false;
+    }
+    
+    mWriterCondition.notify_all();
+    mWriterThread.join();
+}
+
+bool SnapshotWriter::saveAsync(EntityRegistry &registry, std::string filePath)
+{
+    PROFILE_ZONE("SnapshotWriter::saveAsync")
+    
+    {
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        
+        // The writer still owns the snapshot, skip this save rather than stall the frame
+        if (!mRunning || mSavePending)
+            return false;
+    }
+    
+    // Safe without the lock, the writer thread doesn't touch the snapshot until a save is pending
+    SaveState::captureSnapshot(registry, mSnapshot);
+    mFilePath = filePath;
+    
+    {
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        
+        mSavePending = true;
+    }
+    
+    mWriterCondition.notify_one();
+    
+    return true;
+}
+
+bool SnapshotWriter::isSaving()
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    
+    return mSavePending;
+}
+
+bool SnapshotWriter::lastSaveSucceeded()
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    
+    return mLastSaveSucceeded;
+}
+
+void SnapshotWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mWriterMutex);
+    
+    while (true)
+    {
+        mWriterCondition.wait(lock, [this]()
+        {
+            return !mRunning || mSavePending;
+        });
+        
+        // A save already captured is still written before stopping
+        if (!mSavePending)
+            break;
+        
+        lock.unlock();
+        
+        bool success = SaveState::writeSnapshot(mSnapshot, mFilePath);
+        
+        lock.lock();
+        
+        mLastSaveSucceeded = success;
+        mSavePending = false;
+    }
+}
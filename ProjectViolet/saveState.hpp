@@ -0,0 +1,95 @@
+//
+//  saveState.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef saveState_hpp
+#define saveState_hpp
+
+#include <condition_variable>
+#include <mutex>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "components.hpp"
+#include "entityRegistry.hpp"
+
+// The simulation state of the world, held as flat arrays so capturing it is a handful of copies
+// Sprites are presentation and are left to the code that created them
+struct WorldSnapshot
+{
+    // Every live entity, so loading recreates them with the same slots and generations
+    std::vector<Entity> entities;
+    
+    std::vector<Entity> transformEntities;
+    std::vector<Transform> transforms;
+    
+    std::vector<Entity> velocityEntities;
+    std::vector<Velocity> velocities;
+};
+
+namespace SaveState
+{
+    const Uint32 SAVE_MAGIC = 0x56415356; // "VSAV"
+    const Uint32 SAVE_VERSION = 2;
+    
+    // Copies the registry's live entities, transforms and velocities into the snapshot, reusing its storage
+    void captureSnapshot(EntityRegistry &registry, WorldSnapshot &snapshot);
+    
+    // Replaces the registry's entities with the saved ones and gives them back their transforms and velocities,
+    // returns false if the save had components for entities it doesn't list
+    bool restoreSnapshot(WorldSnapshot &snapshot, EntityRegistry &registry);
+    
+    // Encodes, compresses and writes a snapshot, replacing the file only once the new one is complete
+    bool writeSnapshot(WorldSnapshot &snapshot, std::string filePath);
+    
+    // Reads a save file straight into the snapshot's arrays
+    bool readSnapshot(std::string filePath, WorldSnapshot &snapshot);
+}
+
+// Saves snapshots on a background thread, so the main thread only pays for the capture
+class SnapshotWriter
+{
+public:
+    // Initializes the writer without starting its thread
+    SnapshotWriter();
+    
+    // Finishes the save in progress and stops the thread
+    ~SnapshotWriter();
+    
+    void start();
+    
+    // Waits for the save in progress, then stops the thread
+    void stop();
+    
+    // Captures the world and hands it to the writer thread, returns false without capturing if the last save isn't done
+    bool saveAsync(EntityRegistry &registry, std::string filePath);
+    
+    // Returns whether a save is being written
+    bool isSaving();
+    
+    // Returns whether the last finished save succeeded
+    bool lastSaveSucceeded();
+
+private:
+    void writerLoop();
+    
+    // Captured on the main thread and written on the writer thread, never both at once
+    WorldSnapshot mSnapshot;
+    std::string mFilePath;
+    
+    std::thread mWriterThread;
+    
+    std::mutex mWriterMutex;
+    std::condition_variable mWriterCondition;
+    
+    bool mSavePending, mLastSaveSucceeded, mRunning;
+};
+
+#endif /* saveState_hpp */
@@ -0,0 +1,196 @@
+//
+//  spatialHash.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "profiler.hpp"
+#include "spatialHash.hpp"
+
+#include <algorithm>
+
+SpatialHash::SpatialHash(int cellSize) : mCellSize(cellSize > 0 ? cellSize : 128), mQueryStamp(0), mCount(0)
+{
+    
+}
+
+Uint64 SpatialHash::cellKey(int x, int y)
+{
+    return (static_cast<Uint64>(static_cast<Uint32>(x)) << 32) | static_cast<Uint32>(y);
+}
+
+SpatialHash::CellRange SpatialHash::findCells(const SDL_Rect &bounds)
+{
+    // Floor division so negative coordinates land in the right cell
+    auto cellOf = [this](int coordinate)
+    {
+        return coordinate >= 0 ? coordinate / mCellSize : -((-coordinate - 1) / mCellSize) - 1;
+    };
+    
+    return {cellOf(bounds.x), cellOf(bounds.y), cellOf(bounds.x + std::max(bounds.w, 1) - 1), cellOf(bounds.y + std::max(bounds.h, 1) - 1)};
+}
+
+void SpatialHash::addToCells(Uint32 index, const CellRange &cells)
+{
+    for (int y = cells.minY; y <= cells.maxY; y++)
+    {
+        for (int x = cells.minX; x <= cells.maxX; x++)
+            mCells[cellKey(x, y)].push_back(index);
+    }
+}
+
+void SpatialHash::removeFromCells(Uint32 index, const CellRange &cells)
+{
+    for (int y = cells.minY; y <= cells.maxY; y++)
+    {
+        for (int x = cells.minX; x <= cells.maxX; x++)
+        {
+            auto cell = mCells.find(cellKey(x, y));
+            
+            if (cell == mCells.end())
+                continue;
+            
+            std::vector<Uint32> &bucket = cell->second;
+            auto entry = std::find(bucket.begin(), bucket.end(), index);
+            
+            // Order inside a bucket doesn't matter, so swap-remove
+            if (entry != bucket.end())
+            {
+                *entry = bucket.back();
+                bucket.pop_back();
+            }
+            
+            // Empty buckets are kept along with their capacity, so moving back into the cell doesn't allocate
+        }
+    }
+}
+
+void SpatialHash::insert(Entity entity, SDL_Rect bounds)
+{
+    if (entity.index >= mProxies.size())
+        mProxies.resize(entity.index + 1, {NULL_ENTITY, {0, 0, 0, 0}, {0, 0, -1, -1}, 0, false});
+    
+    Proxy &proxy = mProxies[entity.index];
+    
+    // A previous entity in the same slot was never removed
+    if (proxy.present && proxy.entity != entity)
+        remove(proxy.entity);
+    
+    if (proxy.present)
+    {
+        update(entity, bounds);
+        
+        return;
+    }
+    
+    proxy = {entity, bounds, findCells(bounds), mQueryStamp, true};
+    
+    addToCells(entity.index, proxy.cells);
+    
+    mCount++;
+}
+
+void SpatialHash::update(Entity entity, SDL_Rect bounds)
+{
+    if (!contains(entity))
+    {
+        insert(entity, bounds);
+        
+        return;
+    }
+    
+    Proxy &proxy = mProxies[entity.index];
+    
+    proxy.bounds = bounds;
+    
+    CellRange cells = findCells(bounds);
+    
+    // Most moves stay inside the same cells, which costs nothing beyond storing the bounds
+    if (cells == proxy.cells)
+        return;
+    
+    removeFromCells(entity.index, proxy.cells);
+    addToCells(entity.index, cells);
+    
+    proxy.cells = cells;
+}
+
+void SpatialHash::remove(Entity entity)
+{
+    if (!contains(entity))
+        return;
+    
+    Proxy &proxy = mProxies[entity.index];
+    
+    removeFromCells(entity.index, proxy.cells);
+    
+    proxy.present = false;
+    proxy.entity = NULL_ENTITY;
+    
+    mCount--;
+}
+
+bool SpatialHash::contains(Entity entity)
+{
+    return entity.index < mProxies.size() && mProxies[entity.index].present && mProxies[entity.index].entity == entity;
+}
+
+const std::vector<Entity>& SpatialHash::query(SDL_Rect area)
+{
+    PROFILE_ZONE("SpatialHash::query")
+    
+    mQueryResults.clear();
+    
+    // Reset the stamps on the rare wrap around so old stamps can't match
+    if (++mQueryStamp == 0)
+    {
+        for (Proxy &proxy : mProxies)
+            proxy.lastQuery = 0;
+        
+        mQueryStamp = 1;
+    }
+    
+    CellRange cells = findCells(area);
+    
+    for (int y = cells.minY; y <= cells.maxY; y++)
+    {
+        for (int x = cells.minX; x <= cells.maxX; x++)
+        {
+            auto cell = mCells.find(cellKey(x, y));
+            
+            if (cell == mCells.end())
+                continue;
+            
+            for (Uint32 index : cell->second)
+            {
+                Proxy &proxy = mProxies[index];
+                
+                if (proxy.lastQuery == mQueryStamp)
+                    continue;
+                
+                proxy.lastQuery = mQueryStamp;
+                
+                // The cells only bound the search, the rectangles decide
+                if (SDL_HasIntersection(&proxy.bounds, &area))
+                    mQueryResults.push_back(proxy.entity);
+            }
+        }
+    }
+    
+    // Keep the results in a stable order so overlapping sprites don't flicker between frames
+    std::sort(mQueryResults.begin(), mQueryResults.end(), [](const Entity &a, const Entity &b)
+    {
+        return a.index < b.index;
+    });
+    
+    PROFILE_COUNTER("Spatial query results", mQueryResults.size())
+    
+    return mQueryResults;
+}
+
+size_t SpatialHash::size()
+{
+    return mCount;
+}
@@ -0,0 +1,88 @@
+//
+//  spatialHash.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef spatialHash_hpp
+#define spatialHash_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+#include <unordered_map>
+#include <vector>
+
+#include "entityRegistry.hpp"
+
+// A uniform grid over the world, only the cells something has overlapped are stored, and they are kept once empty
+// so steady movement over the same area never allocates
+class SpatialHash
+{
+public:
+    // Initializes an empty hash, cells should be a few times the size of a typical object
+    SpatialHash(int cellSize = 128);
+    
+    // Adds an entity, or moves it if it is already in the hash
+    void insert(Entity entity, SDL_Rect bounds);
+    
+    // Moves an entity, only touching the buckets when it crosses into different cells
+    void update(Entity entity, SDL_Rect bounds);
+    
+    // Removes an entity if it is in the hash
+    void remove(Entity entity);
+    
+    // Returns whether the entity (this generation of it) is in the hash
+    bool contains(Entity entity);
+    
+    // Finds every entity whose bounds overlap the area, sorted by index, the result is reused by the next query
+    const std::vector<Entity>& query(SDL_Rect area);
+    
+    // Returns the number of entities in the hash
+    size_t size();
+
+private:
+    // Inclusive range of cells a rectangle covers
+    struct CellRange
+    {
+        int minX, minY, maxX, maxY;
+        
+        bool operator==(const CellRange &other) const
+        {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+    
+    struct Proxy
+    {
+        Entity entity;
+        SDL_Rect bounds;
+        CellRange cells;
+        Uint32 lastQuery;
+        bool present;
+    };
+    
+    CellRange findCells(const SDL_Rect &bounds);
+    
+    static Uint64 cellKey(int x, int y);
+    
+    void addToCells(Uint32 index, const CellRange &cells);
+    void removeFromCells(Uint32 index, const CellRange &cells);
+    
+    int mCellSize;
+    
+    // Proxies are indexed by entity slot, so lookups never hash
+    std::vector<Proxy> mProxies;
+    
+    std::unordered_map<Uint64, std::vector<Uint32>> mCells;
+    
+    // Stamped into proxies so an entity spanning several cells is only reported once per query
+    Uint32 mQueryStamp;
+    
+    std::vector<Entity> mQueryResults;
+    
+    size_t mCount;
+};
+
+#endif /* spatialHash_hpp */
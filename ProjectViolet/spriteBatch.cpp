@@ -0,0 +1,201 @@
+//
+//  spriteBatch.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "profiler.hpp"
+#include "spriteBatch.hpp"
+
+#include <cmath>
+
+SpriteBatch::SpriteBatch() : mRenderer(nullptr), mActiveBatches(0), mLastSpriteCount(0), mLastBatchCount(0)
+{
+
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    mBatches.clear();
+    mRenderer = nullptr;
+}
+
+void SpriteBatch::begin(std::shared_ptr<SDL_Renderer> &renderer)
+{
+    mRenderer = renderer;
+    
+    // Keep the batch storage, only forget what was queued
+    for (size_t i = 0; i < mActiveBatches; i++)
+        mBatches[i].sprites.clear();
+    
+    mActiveBatches = 0;
+}
+
+SpriteBatch::Batch& SpriteBatch::findBatch(SDL_Texture *texture, SDL_BlendMode blendMode, int textureWidth, int textureHeight)
+{
+    // A frame only touches a handful of atlas pages, so a linear search beats hashing
+    for (size_t i = 0; i < mActiveBatches; i++)
+    {
+        if (mBatches[i].texture == texture && mBatches[i].blendMode == blendMode)
+            return mBatches[i];
+    }
+    
+    if (mActiveBatches == mBatches.size())
+        mBatches.push_back({nullptr, SDL_BLENDMODE_BLEND, 0.0f, 0.0f, {}});
+    
+    Batch &batch = mBatches[mActiveBatches++];
+    
+    batch.texture = texture;
+    batch.blendMode = blendMode;
+    batch.inverseWidth = 1.0f / textureWidth;
+    batch.inverseHeight = 1.0f / textureHeight;
+    batch.sprites.clear();
+    
+    return batch;
+}
+
+void SpriteBatch::draw(SDL_Texture *texture, int textureWidth, int textureHeight, const SDL_Rect &source, const SDL_FRect &destination, double angle, SDL_RendererFlip flip, SDL_Color color, SDL_BlendMode blendMode)
+{
+    if (texture == nullptr || textureWidth <= 0 || textureHeight <= 0)
+        return;
+    
+    findBatch(texture, blendMode, textureWidth, textureHeight).sprites.push_back({source, destination, static_cast<float>(angle), flip, color});
+}
+
+void SpriteBatch::draw(TextureAtlas &atlas, const AtlasRegion &region, const SDL_FRect &destination, double angle, SDL_RendererFlip flip, SDL_Color color, SDL_BlendMode blendMode)
+{
+    std::shared_ptr<TextureAsset> page = atlas.getPage(region.page);
+    
+    if (page)
+        draw(page->getTexture(), page->getWidth(), page->getHeight(), region.rect, destination, angle, flip, color, blendMode);
+}
+
+void SpriteBatch::flush()
+{
+    PROFILE_ZONE("SpriteBatch::flush")
+    
+    mLastSpriteCount = 0;
+    mLastBatchCount = 0;
+    
+    for (size_t i = 0; i < mActiveBatches; i++)
+    {
+        Batch &batch = mBatches[i];
+        
+        if (batch.sprites.empty())
+            continue;
+        
+        mLastSpriteCount += static_cast<int>(batch.sprites.size());
+        mLastBatchCount++;
+        
+        // Queued and immediate draws leave their own blend mode on the shared texture
+        SDL_SetTextureBlendMode(batch.texture, batch.blendMode);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        mVertices.clear();
+        mIndices.clear();
+        
+        for (const Sprite &sprite : batch.sprites)
+        {
+            // Texture coordinates of the source corners, swapped to flip the quad
+            float u0 = sprite.source.x * batch.inverseWidth;
+            float v0 = sprite.source.y * batch.inverseHeight;
+            float u1 = (sprite.source.x + sprite.source.w) * batch.inverseWidth;
+            float v1 = (sprite.source.y + sprite.source.h) * batch.inverseHeight;
+            
+            if (sprite.flip & SDL_FLIP_HORIZONTAL)
+                std::swap(u0, u1);
+            
+            if (sprite.flip & SDL_FLIP_VERTICAL)
+                std::swap(v0, v1);
+            
+            // Corner offsets from the quad's center, matching SDL_RenderCopyEx's default rotation point
+            float halfWidth = sprite.destination.w * 0.5f;
+            float halfHeight = sprite.destination.h * 0.5f;
+            float centerX = sprite.destination.x + halfWidth;
+            float centerY = sprite.destination.y + halfHeight;
+            
+            float cosine = 1.0f, sine = 0.0f;
+            
+            if (sprite.angle != 0.0f)
+            {
+                float radians = sprite.angle * static_cast<float>(M_PI / 180.0);
+                
+                cosine = std::cos(radians);
+                sine = std::sin(radians);
+            }
+            
+            const float cornerX[4] = {-halfWidth, halfWidth, halfWidth, -halfWidth};
+            const float cornerY[4] = {-halfHeight, -halfHeight, halfHeight, halfHeight};
+            const float cornerU[4] = {u0, u1, u1, u0};
+            const float cornerV[4] = {v0, v0, v1, v1};
+            
+            int firstVertex = static_cast<int>(mVertices.size());
+            
+            for (int corner = 0; corner < 4; corner++)
+            {
+                SDL_Vertex vertex;
+                
+                vertex.position.x = centerX + cornerX[corner] * cosine - cornerY[corner] * sine;
+                vertex.position.y = centerY + cornerX[corner] * sine + cornerY[corner] * cosine;
+                vertex.color = sprite.color;
+                vertex.tex_coord.x = cornerU[corner];
+                vertex.tex_coord.y = cornerV[corner];
+                
+                mVertices.push_back(vertex);
+            }
+            
+            // Two triangles per quad
+            mIndices.insert(mIndices.end(), {firstVertex, firstVertex + 1, firstVertex + 2, firstVertex, firstVertex + 2, firstVertex + 3});
+        }
+        
+        // The whole page goes out in one vertex array draw
+        SDL_RenderGeometry(mRenderer.get(), batch.texture, mVertices.data(), static_cast<int>(mVertices.size()), mIndices.data(), static_cast<int>(mIndices.size()));
+#else
+        // Without SDL_RenderGeometry the quads are still submitted back to back on one texture, which
+        // SDL's render batching merges into few draw calls, and color mods are only changed when needed
+        SDL_Color currentColor = {0xFF, 0xFF, 0xFF, 0xFF};
+        
+        SDL_SetTextureColorMod(batch.texture, currentColor.r, currentColor.g, currentColor.b);
+        SDL_SetTextureAlphaMod(batch.texture, currentColor.a);
+        
+        for (const Sprite &sprite : batch.sprites)
+        {
+            if (sprite.color.r != currentColor.r || sprite.color.g != currentColor.g || sprite.color.b != currentColor.b || sprite.color.a != currentColor.a)
+            {
+                currentColor = sprite.color;
+                
+                SDL_SetTextureColorMod(batch.texture, currentColor.r, currentColor.g, currentColor.b);
+                SDL_SetTextureAlphaMod(batch.texture, currentColor.a);
+            }
+            
+            SDL_RenderCopyExF(mRenderer.get(), batch.texture, &sprite.source, &sprite.destination, sprite.angle, nullptr, sprite.flip);
+        }
+#endif
+
+        batch.sprites.clear();
+    }
+    
+    mActiveBatches = 0;
+}
+
+int SpriteBatch::getPendingSpriteCount()
+{
+    int pendingCount = 0;
+    
+    for (size_t i = 0; i < mActiveBatches; i++)
+        pendingCount += static_cast<int>(mBatches[i].sprites.size());
+    
+    return pendingCount;
+}
+
+int SpriteBatch::getLastSpriteCount()
+{
+    return mLastSpriteCount;
+}
+
+int SpriteBatch::getLastBatchCount()
+{
+    return mLastBatchCount;
+}
@@ -0,0 +1,92 @@
+//
+//  spriteBatch.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef spriteBatch_hpp
+#define spriteBatch_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+#include "textureAtlas.hpp"
+
+// Collects textured quads over a frame and draws all quads sharing a texture and blend mode together
+class SpriteBatch
+{
+public:
+    // Initializes an empty batch
+    SpriteBatch();
+    
+    // Drops any unflushed quads
+    ~SpriteBatch();
+    
+    // Starts collecting quads for the passed renderer
+    void begin(std::shared_ptr<SDL_Renderer> &renderer);
+    
+    // Queues a quad showing the source rectangle of a texture, rotated about the destination's center
+    void draw(SDL_Texture *texture, int textureWidth, int textureHeight, const SDL_Rect &source, const SDL_FRect &destination, double angle = 0.0, SDL_RendererFlip flip = SDL_FLIP_NONE, SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF}, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+    
+    // Queues a quad showing an image packed into an atlas
+    void draw(TextureAtlas &atlas, const AtlasRegion &region, const SDL_FRect &destination, double angle = 0.0, SDL_RendererFlip flip = SDL_FLIP_NONE, SDL_Color color = {0xFF, 0xFF, 0xFF, 0xFF}, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+    
+    // Draws every queued quad, one draw per texture and blend mode, and empties the batch
+    void flush();
+    
+    // Returns the number of quads queued since the last flush
+    int getPendingSpriteCount();
+    
+    // Returns the number of quads drawn by the last flush
+    int getLastSpriteCount();
+    
+    // Returns the number of texture and blend mode pairs (and so draw submissions) used by the last flush
+    int getLastBatchCount();
+
+private:
+    // A queued quad, kept as a plain record so vertices are only built once per flush
+    struct Sprite
+    {
+        SDL_Rect source;
+        SDL_FRect destination;
+        float angle;
+        SDL_RendererFlip flip;
+        SDL_Color color;
+    };
+    
+    // Every queued quad for one texture drawn with one blend mode, the mode is set on the texture when the batch is
+    // drawn since other draws of the same texture may have left a different one
+    struct Batch
+    {
+        SDL_Texture *texture;
+        SDL_BlendMode blendMode;
+        float inverseWidth, inverseHeight;
+        std::vector<Sprite> sprites;
+    };
+    
+    // Returns the batch for a texture and blend mode, creating it on first use this frame
+    Batch& findBatch(SDL_Texture *texture, SDL_BlendMode blendMode, int textureWidth, int textureHeight);
+    
+    // Pointer to the renderer so that it doesn't have to be passed to every draw
+    std::shared_ptr<SDL_Renderer> mRenderer;
+    
+    // Batches are kept between frames so their storage is reused
+    std::vector<Batch> mBatches;
+    
+    // Number of batches in use this frame
+    size_t mActiveBatches;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Scratch vertex and index arrays reused across flushes
+    std::vector<SDL_Vertex> mVertices;
+    std::vector<int> mIndices;
+#endif
+
+    int mLastSpriteCount, mLastBatchCount;
+};
+
+#endif /* spriteBatch_hpp */
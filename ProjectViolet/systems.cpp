@@ -0,0 +1,201 @@
+//
+//  systems.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "profiler.hpp"
+#include "systems.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Systems
+{
+    void storePreviousTransforms(EntityRegistry &registry, JobSystem &jobSystem)
+    {
+        PROFILE_ZONE("Systems::storePreviousTransforms")
+        
+        // Only the transforms are touched, so walk their dense array directly
+        std::vector<Transform> &transforms = registry.pool<Transform>().components();
+        
+        jobSystem.parallelFor(0, transforms.size(), PARALLEL_GRAIN_SIZE, [&transforms](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                transforms[i].previousX = transforms[i].x;
+                transforms[i].previousY = transforms[i].y;
+            }
+        });
+    }
+    
+    void integrateMovement(EntityRegistry &registry, double deltaTime, JobSystem &jobSystem)
+    {
+        PROFILE_ZONE("Systems::integrateMovement")
+        
+        const float step = static_cast<float>(deltaTime);
+        
+        ComponentPool<Velocity> &velocities = registry.pool<Velocity>();
+        ComponentPool<Transform> &transforms = registry.pool<Transform>();
+        
+        // Every velocity moves a different transform, so the ranges never write to the same data
+        jobSystem.parallelFor(0, velocities.size(), PARALLEL_GRAIN_SIZE, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                Transform *transform = transforms.find(velocities.entities()[i]);
+                
+                if (transform == nullptr)
+                    continue;
+                
+                const Velocity &velocity = velocities.components()[i];
+                
+                transform->x += velocity.x * step;
+                transform->y += velocity.y * step;
+            }
+        });
+    }
+    
+    void updateColliders(EntityRegistry &registry, CollisionWorld &collisionWorld)
+    {
+        PROFILE_ZONE("Systems::updateColliders")
+        
+        // Every live collider is touched each step, which is also how the world notices the ones that went away
+        registry.each<Collider, Transform>([&collisionWorld](Entity entity, Collider &collider, Transform &transform)
+        {
+            float minX = transform.x + collider.offsetX;
+            float minY = transform.y + collider.offsetY;
+            
+            collisionWorld.update(entity, minX, minY, minX + collider.width, minY + collider.height);
+        });
+    }
+    
+    SDL_Rect findSpriteBounds(const Sprite &sprite, const Transform &transform)
+    {
+        float minX = std::min(transform.previousX, transform.x);
+        float minY = std::min(transform.previousY, transform.y);
+        float maxX = std::max(transform.previousX, transform.x) + sprite.width;
+        float maxY = std::max(transform.previousY, transform.y) + sprite.height;
+        
+        // Rotation happens around the center, so a rotated sprite stays inside the circle through its corners
+        if (transform.angle != 0.0)
+        {
+            float halfWidth = sprite.width * 0.5f;
+            float halfHeight = sprite.height * 0.5f;
+            float growth = std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight);
+            
+            minX -= growth - halfWidth;
+            minY -= growth - halfHeight;
+            maxX += growth - halfWidth;
+            maxY += growth - halfHeight;
+        }
+        
+        int left = static_cast<int>(std::floor(minX));
+        int top = static_cast<int>(std::floor(minY));
+        
+        return {left, top, static_cast<int>(std::ceil(maxX)) - left, static_cast<int>(std::ceil(maxY)) - top};
+    }
+    
+    void updateSpatialIndex(EntityRegistry &registry, SpatialHash &spatialIndex)
+    {
+        PROFILE_ZONE("Systems::updateSpatialIndex")
+        
+        ComponentPool<Sprite> &sprites = registry.pool<Sprite>();
+        ComponentPool<Transform> &transforms = registry.pool<Transform>();
+        ComponentPool<Velocity> &velocities = registry.pool<Velocity>();
+        
+        // The first time through every existing sprite is new
+        if (!sprites.isTrackingAdditions())
+        {
+            sprites.trackAdditions();
+            sprites.added() = sprites.entities();
+            
+            sprites.trackChanges();
+            transforms.trackChanges();
+            velocities.trackChanges();
+        }
+        
+        auto reindex = [&spatialIndex, &sprites, &transforms](Entity entity)
+        {
+            Sprite *sprite = sprites.find(entity);
+            Transform *transform = transforms.find(entity);
+            
+            if (sprite && transform)
+                spatialIndex.update(entity, findSpriteBounds(*sprite, *transform));
+        };
+        
+        // New sprites go in once, static ones are never touched again unless something reports a change
+        for (Entity entity : sprites.added())
+            reindex(entity);
+        
+        // Teleports and resizes, plus lost velocities, whose last step of movement the loop below no longer sees
+        for (Entity entity : sprites.changed())
+            reindex(entity);
+        
+        for (Entity entity : transforms.changed())
+            reindex(entity);
+        
+        for (Entity entity : velocities.changed())
+            reindex(entity);
+        
+        sprites.clearAdded();
+        sprites.clearChanged();
+        transforms.clearChanged();
+        velocities.clearChanged();
+        
+        // Only moving sprites pay for an update, and most of those stay in the same cells
+        registry.each<Velocity, Transform, Sprite>([&spatialIndex](Entity entity, Velocity&, Transform &transform, Sprite &sprite)
+        {
+            spatialIndex.update(entity, findSpriteBounds(sprite, transform));
+        });
+    }
+    
+    void renderSprites(EntityRegistry &registry, SpatialHash &spatialIndex, RenderQueue &renderQueue, SDL_Rect camera, double interpolation)
+    {
+        PROFILE_ZONE("Systems::renderSprites")
+        
+        const float alpha = static_cast<float>(interpolation);
+        
+        ComponentPool<Sprite> &sprites = registry.pool<Sprite>();
+        ComponentPool<Transform> &transforms = registry.pool<Transform>();
+        
+        // Only what overlaps the camera is visited, so the cost follows what's on screen rather than the world size
+        for (Entity entity : spatialIndex.query(camera))
+        {
+            Sprite *sprite = sprites.find(entity);
+            Transform *transform = transforms.find(entity);
+            
+            // The index isn't told about destroyed entities, drop them the first time they are seen
+            if (!sprite || !transform)
+            {
+                spatialIndex.remove(entity);
+                
+                continue;
+            }
+            
+            if (!sprite->texture)
+                continue;
+            
+            // Blend between the last two simulated positions so motion stays smooth at any frame rate
+            float x = transform->previousX + (transform->x - transform->previousX) * alpha;
+            float y = transform->previousY + (transform->y - transform->previousY) * alpha;
+            
+            DrawCommand command;
+            
+            command.texture = sprite->texture->getTexture();
+            command.source = sprite->source;
+            command.destination = {static_cast<int>(x) - camera.x, static_cast<int>(y) - camera.y, sprite->width, sprite->height};
+            command.angle = transform->angle;
+            command.center = {0, 0};
+            command.hasCenter = false;
+            command.flip = SDL_FLIP_NONE;
+            command.colorModulation = sprite->colorModulation;
+            command.blendMode = sprite->blendMode;
+            command.layer = sprite->layer;
+            
+            renderQueue.submit(command);
+        }
+    }
+}
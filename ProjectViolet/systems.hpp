@@ -0,0 +1,49 @@
+//
+//  systems.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef systems_hpp
+#define systems_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+
+#include "collisionWorld.hpp"
+#include "components.hpp"
+#include "entityRegistry.hpp"
+#include "jobSystem.hpp"
+#include "renderQueue.hpp"
+#include "spatialHash.hpp"
+
+namespace Systems
+{
+    // Entities handed to each job by the parallel systems
+    const size_t PARALLEL_GRAIN_SIZE = 4096;
+    
+    // Remembers every transform's position before the update moves it, for render interpolation
+    void storePreviousTransforms(EntityRegistry &registry, JobSystem &jobSystem);
+    
+    // Moves every entity with a velocity by one fixed step
+    void integrateMovement(EntityRegistry &registry, double deltaTime, JobSystem &jobSystem);
+    
+    // Inserts newly created sprites into the index and moves the ones with a velocity, every other sprite is only
+    // re-indexed when its Transform or Sprite is replaced through emplace(), or when whoever modifies one in place
+    // (a teleport, a resize) calls registry.markChanged<Transform>() or markChanged<Sprite>() for it
+    // Losing a Velocity re-indexes the sprite too, so its last step of movement isn't missed
+    void updateSpatialIndex(EntityRegistry &registry, SpatialHash &spatialIndex);
+    
+    // Moves every collider's body to its entity's current position, colliders that are gone drop out of the world
+    void updateColliders(EntityRegistry &registry, CollisionWorld &collisionWorld);
+    
+    // Returns the area a sprite can cover while being interpolated between its last two positions
+    SDL_Rect findSpriteBounds(const Sprite &sprite, const Transform &transform);
+    
+    // Records a draw command for every sprite the camera can see, interpolated between the last two updates
+    void renderSprites(EntityRegistry &registry, SpatialHash &spatialIndex, RenderQueue &renderQueue, SDL_Rect camera, double interpolation);
+}
+
+#endif /* systems_hpp */
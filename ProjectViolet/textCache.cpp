@@ -0,0 +1,172 @@
+//
+//  textCache.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "pixelConversion.hpp"
+#include "profiler.hpp"
+#include "textCache.hpp"
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace
+{
+    // One rendered text and everything that went into rendering it
+    struct TextEntry
+    {
+        size_t hash;
+        std::string text;
+        
+        // Fonts are only observed, a font freed and another opened at the same address mustn't hit the old entry
+        std::weak_ptr<TTF_Font> font;
+        int fontHeight;
+        
+        Uint32 color;
+        Uint32 wrapWidth;
+        SDL_Renderer *renderer;
+        
+        std::shared_ptr<TextureAsset> texture;
+    };
+    
+    // Most recently used at the front
+    std::list<TextEntry> mEntries;
+    
+    // Indexed by the hash of the text and its settings, a different text with the same hash just replaces the entry
+    std::unordered_map<size_t, std::list<TextEntry>::iterator> mEntryIndex;
+    
+    size_t mCapacity = TextCache::DEFAULT_CAPACITY;
+    
+    int mHitCount = 0;
+    int mMissCount = 0;
+    
+    size_t hashText(const std::string &text, TTF_Font *font, int fontHeight, Uint32 color, Uint32 wrapWidth, SDL_Renderer *renderer)
+    {
+        // Combine the member hashes the same way boost::hash_combine does
+        size_t seed = std::hash<std::string>()(text);
+        seed ^= std::hash<TTF_Font*>()(font) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<int>()(fontHeight) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<Uint32>()(color) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<Uint32>()(wrapWidth) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<SDL_Renderer*>()(renderer) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        
+        return seed;
+    }
+    
+    void removeEntry(std::list<TextEntry>::iterator entry)
+    {
+        mEntryIndex.erase(entry->hash);
+        mEntries.erase(entry);
+    }
+    
+    void trimToCapacity()
+    {
+        while (mEntries.size() > mCapacity)
+            removeEntry(std::prev(mEntries.end()));
+    }
+}
+
+namespace TextCache
+{
+    std::shared_ptr<TextureAsset> renderText(const std::string &text, std::shared_ptr<TTF_Font> &font, SDL_Color color, Uint32 wrapWidth, std::shared_ptr<SDL_Renderer> &renderer)
+    {
+        PROFILE_ZONE("TextCache::renderText")
+        
+        int fontHeight = TTF_FontHeight(font.get());
+        Uint32 packedColor = static_cast<Uint32>((color.r << 24) | (color.g << 16) | (color.b << 8) | color.a);
+        
+        size_t hash = hashText(text, font.get(), fontHeight, packedColor, wrapWidth, renderer.get());
+        
+        auto indexedEntry = mEntryIndex.find(hash);
+        
+        if (indexedEntry != mEntryIndex.end())
+        {
+            std::list<TextEntry>::iterator entry = indexedEntry->second;
+            
+            if (entry->text == text && entry->font.lock() == font && entry->fontHeight == fontHeight && entry->color == packedColor && entry->wrapWidth == wrapWidth && entry->renderer == renderer.get())
+            {
+                // Move to the front without reallocating the node
+                mEntries.splice(mEntries.begin(), mEntries, entry);
+                
+                mHitCount++;
+                
+                return entry->texture;
+            }
+            
+            removeEntry(entry);
+        }
+        
+        mMissCount++;
+        
+        // Create a surface containing the text using TTF
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> textSurface(TTF_RenderText_Blended_Wrapped(font.get(), text.c_str(), color, wrapWidth), &SDL_FreeSurface);
+        
+        if (!textSurface)
+        {
+            LOG_MESSAGE(SevereError, "Unable to render text to a surface!")
+            LOG_MESSAGE(SDLFontError, "%s", TTF_GetError())
+            
+            return nullptr;
+        }
+        
+        SDL_Texture *texture = PixelConversion::createTexture(renderer.get(), textSurface.get(), SDL_PIXELFORMAT_UNKNOWN);
+        
+        if (texture == nullptr)
+        {
+            LOG_MESSAGE(SevereError, "Unable to convert the rendered text to a texture!")
+            LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+            
+            return nullptr;
+        }
+        
+        std::shared_ptr<TextureAsset> textTexture = std::make_shared<TextureAsset>(texture, textSurface->w, textSurface->h);
+        
+        mEntries.push_front({hash, text, font, fontHeight, packedColor, wrapWidth, renderer.get(), textTexture});
+        mEntryIndex[hash] = mEntries.begin();
+        
+        // With a capacity of zero the new entry goes straight back out, the caller still gets its texture
+        trimToCapacity();
+        
+        PROFILE_COUNTER("Cached texts", mEntries.size())
+        
+        return textTexture;
+    }
+    
+    void setCapacity(size_t capacity)
+    {
+        mCapacity = capacity;
+        
+        trimToCapacity();
+    }
+    
+    size_t getCapacity()
+    {
+        return mCapacity;
+    }
+    
+    void clearTextCache()
+    {
+        mEntryIndex.clear();
+        mEntries.clear();
+    }
+    
+    int getCachedTextCount()
+    {
+        return static_cast<int>(mEntries.size());
+    }
+    
+    int getHitCount()
+    {
+        return mHitCount;
+    }
+    
+    int getMissCount()
+    {
+        return mMissCount;
+    }
+}
@@ -0,0 +1,48 @@
+//
+//  textCache.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef textCache_hpp
+#define textCache_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdio.h>
+#include <string>
+
+#include "assetManager.hpp"
+
+// Keeps the textures of recently rendered text so labels rebuilt with the same text skip SDL_ttf, main thread only
+namespace TextCache
+{
+    // Number of texts kept by default, textures still held by a wrapper outlive their cache entry
+    const size_t DEFAULT_CAPACITY = 256;
+    
+    // Returns the texture for the text, only rendering it if no cached copy with the same font, color and wrap width exists
+    std::shared_ptr<TextureAsset> renderText(const std::string &text, std::shared_ptr<TTF_Font> &font, SDL_Color color, Uint32 wrapWidth, std::shared_ptr<SDL_Renderer> &renderer);
+    
+    // Sets how many texts are kept, evicting the least recently used ones beyond it
+    void setCapacity(size_t capacity);
+    
+    // Returns how many texts are kept
+    size_t getCapacity();
+    
+    // Forgets every cached text, must be called before the renderer is destroyed
+    void clearTextCache();
+    
+    // Returns the number of texts currently cached
+    int getCachedTextCount();
+    
+    // Returns the number of lookups that found a cached texture since startup
+    int getHitCount();
+    
+    // Returns the number of lookups that had to render their text since startup
+    int getMissCount();
+}
+
+#endif /* textCache_hpp */
@@ -0,0 +1,299 @@
+//
+//  textureAtlas.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "packArchive.hpp"
+#include "textureAtlas.hpp"
+
+#include <algorithm>
+#include <SDL_image.h>
+
+SkylinePacker::SkylinePacker(int width, int height) : mWidth(0), mHeight(0), mUsedArea(0)
+{
+    reset(width, height);
+}
+
+void SkylinePacker::reset(int width, int height)
+{
+    mWidth = width;
+    mHeight = height;
+    mUsedArea = 0;
+    
+    // The skyline starts out as a single flat run along the bottom of the area
+    mSkyline.clear();
+    mSkyline.push_back({0, 0, width});
+}
+
+int SkylinePacker::fitHeight(size_t nodeIndex, int width, int height)
+{
+    int x = mSkyline[nodeIndex].x;
+    
+    if (x + width > mWidth)
+        return -1;
+    
+    // The rectangle rests on the tallest run it spans
+    int y = 0;
+    int remainingWidth = width;
+    
+    for (size_t i = nodeIndex; remainingWidth > 0; i++)
+    {
+        if (i >= mSkyline.size())
+            return -1;
+        
+        y = std::max(y, mSkyline[i].y);
+        
+        if (y + height > mHeight)
+            return -1;
+        
+        remainingWidth -= mSkyline[i].width;
+    }
+    
+    return y;
+}
+
+bool SkylinePacker::pack(int width, int height, SDL_Point &position)
+{
+    int bestY = mHeight, bestWidth = mWidth + 1;
+    size_t bestIndex = mSkyline.size();
+    
+    // Bottom-left heuristic: lowest resting height first, narrowest run as the tie breaker
+    for (size_t i = 0; i < mSkyline.size(); i++)
+    {
+        int y = fitHeight(i, width, height);
+        
+        if (y >= 0 && (y < bestY || (y == bestY && mSkyline[i].width < bestWidth)))
+        {
+            bestY = y;
+            bestWidth = mSkyline[i].width;
+            bestIndex = i;
+        }
+    }
+    
+    if (bestIndex == mSkyline.size())
+        return false;
+    
+    position = {mSkyline[bestIndex].x, bestY};
+    
+    // Raise the skyline over the new rectangle
+    mSkyline.insert(mSkyline.begin() + bestIndex, {position.x, bestY + height, width});
+    
+    // Shrink or remove the runs now covered by the new one
+    for (size_t i = bestIndex + 1; i < mSkyline.size();)
+    {
+        int shadowEnd = mSkyline[i - 1].x + mSkyline[i - 1].width;
+        
+        if (mSkyline[i].x >= shadowEnd)
+            break;
+        
+        int shrink = shadowEnd - mSkyline[i].x;
+        
+        mSkyline[i].x += shrink;
+        mSkyline[i].width -= shrink;
+        
+        if (mSkyline[i].width <= 0)
+            mSkyline.erase(mSkyline.begin() + i);
+        else
+            break;
+    }
+    
+    // Merge neighbouring runs at the same height
+    for (size_t i = 0; i + 1 < mSkyline.size();)
+    {
+        if (mSkyline[i].y == mSkyline[i + 1].y)
+        {
+            mSkyline[i].width += mSkyline[i + 1].width;
+            mSkyline.erase(mSkyline.begin() + i + 1);
+        }
+        else
+        {
+            i++;
+        }
+    }
+    
+    mUsedArea += static_cast<long>(width) * height;
+    
+    return true;
+}
+
+double SkylinePacker::getOccupancy()
+{
+    if (mWidth == 0 || mHeight == 0)
+        return 0.0;
+    
+    return static_cast<double>(mUsedArea) / (static_cast<double>(mWidth) * mHeight);
+}
+
+TextureAtlas::TextureAtlas(int pageSize, int padding) : mPageSize(pageSize), mPadding(padding)
+{
+
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    mPendingImages.clear();
+}
+
+bool TextureAtlas::addImage(std::string name, std::string filePath, bool colorKeyImage, SDL_Color colorKey)
+{
+    // Loads the image as a SDL surface, from a mounted pack archive when one has it
+    PackEntry packedImage;
+    
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loadedSurface(IMG_LoadTyped_RW(AssetPack::openFile(filePath, packedImage), 1, AssetManager::findImageType(filePath).c_str()), &SDL_FreeSurface);
+    
+    // Check if it loads successfully
+    if (!loadedSurface)
+    {
+        LOG_MESSAGE(SevereError, "Failed to load image from %s!", filePath.c_str())
+        LOG_MESSAGE(SDLImageError, "%s", IMG_GetError())
+        
+        return false;
+    }
+    
+    // Color keys the image if enabled, the key turns into transparent pixels when packed
+    if (colorKeyImage)
+        SDL_SetColorKey(loadedSurface.get(), SDL_TRUE, SDL_MapRGB(loadedSurface->format, colorKey.r, colorKey.g, colorKey.b));
+    
+    return addSurface(name, loadedSurface.get());
+}
+
+bool TextureAtlas::addSurface(std::string name, SDL_Surface *surface)
+{
+    // Pages are always ARGB8888, so convert now rather than once per blit
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> convertedSurface(SDL_CreateRGBSurfaceWithFormat(0, surface->w, surface->h, 32, SDL_PIXELFORMAT_ARGB8888), &SDL_FreeSurface);
+    
+    if (!convertedSurface)
+    {
+        LOG_MESSAGE(SevereError, "Failed to copy %s for the texture atlas!", name.c_str())
+        LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+        
+        return false;
+    }
+    
+    // Copy the pixels straight across, color keyed pixels are skipped and stay transparent
+    SDL_FillRect(convertedSurface.get(), nullptr, 0);
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(surface, nullptr, convertedSurface.get(), nullptr);
+    
+    mPendingImages.push_back({name, std::move(convertedSurface)});
+    
+    return true;
+}
+
+bool TextureAtlas::build(std::shared_ptr<SDL_Renderer> &renderer)
+{
+    bool success = true;
+    
+    // Never make pages larger than the renderer can hold
+    SDL_RendererInfo rendererInfo;
+    
+    if (SDL_GetRendererInfo(renderer.get(), &rendererInfo) == 0 && rendererInfo.max_texture_width > 0)
+        mPageSize = std::min({mPageSize, rendererInfo.max_texture_width, rendererInfo.max_texture_height});
+    
+    // Packing the tallest images first keeps the skyline flat
+    std::stable_sort(mPendingImages.begin(), mPendingImages.end(), [](const PendingImage &a, const PendingImage &b)
+    {
+        return a.surface->h > b.surface->h;
+    });
+    
+    std::vector<SkylinePacker> packers;
+    std::vector<std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>> pageSurfaces;
+    
+    for (PendingImage &image : mPendingImages)
+    {
+        int paddedWidth = image.surface->w + mPadding * 2;
+        int paddedHeight = image.surface->h + mPadding * 2;
+        
+        if (paddedWidth > mPageSize || paddedHeight > mPageSize)
+        {
+            LOG_MESSAGE(Error, "%s is too large for an atlas page!", image.name.c_str())
+            
+            success = false;
+            continue;
+        }
+        
+        SDL_Point position {0, 0};
+        size_t page = 0;
+        
+        // First fit over the existing pages, open a new page only when none has room
+        while (page < packers.size() && !packers[page].pack(paddedWidth, paddedHeight, position))
+            page++;
+        
+        if (page == packers.size())
+        {
+            packers.emplace_back(mPageSize, mPageSize);
+            pageSurfaces.emplace_back(SDL_CreateRGBSurfaceWithFormat(0, mPageSize, mPageSize, 32, SDL_PIXELFORMAT_ARGB8888), &SDL_FreeSurface);
+            
+            if (!pageSurfaces.back())
+            {
+                LOG_MESSAGE(SevereError, "Failed to create an atlas page!")
+                LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+                
+                return false;
+            }
+            
+            SDL_FillRect(pageSurfaces.back().get(), nullptr, 0);
+            packers.back().pack(paddedWidth, paddedHeight, position);
+        }
+        
+        SDL_Rect destination {position.x + mPadding, position.y + mPadding, image.surface->w, image.surface->h};
+        
+        SDL_SetSurfaceBlendMode(image.surface.get(), SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(image.surface.get(), nullptr, pageSurfaces[page].get(), &destination);
+        
+        mRegions[image.name] = {static_cast<int>(mPages.size() + page), destination};
+    }
+    
+    mPendingImages.clear();
+    
+    // Upload every page once
+    for (auto &pageSurface : pageSurfaces)
+    {
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer.get(), pageSurface.get());
+        
+        if (texture == nullptr)
+        {
+            LOG_MESSAGE(SevereError, "Failed to convert an atlas page into a texture!")
+            LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+            
+            success = false;
+        }
+        else
+        {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        }
+        
+        mPages.push_back(texture != nullptr ? std::make_shared<TextureAsset>(texture, mPageSize, mPageSize) : nullptr);
+    }
+    
+    return success;
+}
+
+bool TextureAtlas::findRegion(std::string name, AtlasRegion &region)
+{
+    auto foundRegion = mRegions.find(name);
+    
+    if (foundRegion == mRegions.end())
+        return false;
+    
+    region = foundRegion->second;
+    
+    return true;
+}
+
+std::shared_ptr<TextureAsset> TextureAtlas::getPage(int page)
+{
+    if (page < 0 || page >= static_cast<int>(mPages.size()))
+        return nullptr;
+    
+    return mPages[page];
+}
+
+int TextureAtlas::getPageCount()
+{
+    return static_cast<int>(mPages.size());
+}
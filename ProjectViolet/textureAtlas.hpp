@@ -0,0 +1,109 @@
+//
+//  textureAtlas.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef textureAtlas_hpp
+#define textureAtlas_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "assetManager.hpp"
+
+// Packs rectangles into a fixed size area by tracking the top edge ("skyline") of everything placed so far
+class SkylinePacker
+{
+public:
+    // Creates an empty packer covering the passed area
+    SkylinePacker(int width = 0, int height = 0);
+    
+    // Forgets every packed rectangle and resizes the packing area
+    void reset(int width, int height);
+    
+    // Finds the lowest, then left-most, spot for a rectangle and reserves it, returns false if it doesn't fit
+    bool pack(int width, int height, SDL_Point &position);
+    
+    // Returns the fraction of the area covered by packed rectangles
+    double getOccupancy();
+
+private:
+    // A horizontal run of the skyline starting at x, with everything under y reserved
+    struct SkylineNode
+    {
+        int x, y, width;
+    };
+    
+    // Returns the height a rectangle would rest at if placed on the given node, or -1 if it doesn't fit
+    int fitHeight(size_t nodeIndex, int width, int height);
+    
+    std::vector<SkylineNode> mSkyline;
+    
+    int mWidth, mHeight;
+    
+    long mUsedArea;
+};
+
+// The location of a packed image inside an atlas
+struct AtlasRegion
+{
+    // Index of the atlas page holding the image
+    int page;
+    
+    // The image's rectangle in page pixels
+    SDL_Rect rect;
+};
+
+// Collects images and packs them into a small number of large textures
+class TextureAtlas
+{
+public:
+    // Initializes an empty atlas, pages are square and at most the renderer's maximum texture size
+    TextureAtlas(int pageSize = 2048, int padding = 1);
+    
+    // Frees any images still waiting to be packed
+    ~TextureAtlas();
+    
+    // Loads an image and queues it for packing under the passed name
+    bool addImage(std::string name, std::string filePath, bool colorKeyImage = false, SDL_Color colorKey = {0xFF, 0x00, 0xDC});
+    
+    // Copies a surface and queues it for packing under the passed name
+    bool addSurface(std::string name, SDL_Surface *surface);
+    
+    // Packs every queued image into pages and uploads them to the renderer
+    bool build(std::shared_ptr<SDL_Renderer> &renderer);
+    
+    // Looks up where a named image was packed, returns false if it isn't in the atlas
+    bool findRegion(std::string name, AtlasRegion &region);
+    
+    // Returns the shared texture for a page
+    std::shared_ptr<TextureAsset> getPage(int page);
+    
+    // Returns the number of built pages
+    int getPageCount();
+
+private:
+    // An image waiting for build(...)
+    struct PendingImage
+    {
+        std::string name;
+        std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface;
+    };
+    
+    std::vector<PendingImage> mPendingImages;
+    
+    std::unordered_map<std::string, AtlasRegion> mRegions;
+    
+    std::vector<std::shared_ptr<TextureAsset>> mPages;
+    
+    int mPageSize, mPadding;
+};
+
+#endif /* textureAtlas_hpp */
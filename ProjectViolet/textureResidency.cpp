@@ -0,0 +1,159 @@
+//
+//  textureResidency.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "assetManager.hpp"
+#include "debug.hpp"
+#include "frameArena.hpp"
+#include "profiler.hpp"
+#include "textureResidency.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Every texture asset that currently holds an SDL texture
+    std::vector<TextureAsset*> mResidentTextures;
+    
+    size_t mBudget = TextureResidency::UNLIMITED_BUDGET;
+    size_t mResidentBytes = 0;
+    
+    // Starts at one so textures that were never used sort before ones used on the first frame
+    Uint64 mFrame = 1;
+    
+    int mEvictionCount = 0;
+    int mReloadCount = 0;
+    
+    // Set while the textures used every frame don't fit in the budget, so the warning isn't repeated each frame
+    bool mWorkingSetWarned = false;
+}
+
+namespace TextureResidency
+{
+    void setBudget(size_t bytes)
+    {
+        mBudget = bytes;
+        mWorkingSetWarned = false;
+    }
+    
+    size_t getBudget()
+    {
+        return mBudget;
+    }
+    
+    size_t calculateByteSize(SDL_Texture *texture)
+    {
+        Uint32 format;
+        int width, height;
+        
+        if (texture == nullptr || SDL_QueryTexture(texture, &format, nullptr, &width, &height) != 0)
+            return 0;
+        
+        // YUV formats don't have a whole number of bytes per pixel, two is an upper bound for all of them
+        size_t bytesPerPixel = SDL_ISPIXELFORMAT_FOURCC(format) ? 2 : SDL_BYTESPERPIXEL(format);
+        
+        return static_cast<size_t>(width) * height * bytesPerPixel;
+    }
+    
+    void track(TextureAsset *texture)
+    {
+        mResidentTextures.push_back(texture);
+        mResidentBytes += texture->getByteSize();
+    }
+    
+    void untrack(TextureAsset *texture)
+    {
+        auto resident = std::find(mResidentTextures.begin(), mResidentTextures.end(), texture);
+        
+        if (resident == mResidentTextures.end())
+            return;
+        
+        // Order doesn't matter, so the last texture fills the gap instead of shifting everything down
+        *resident = mResidentTextures.back();
+        mResidentTextures.pop_back();
+        
+        mResidentBytes -= texture->getByteSize();
+    }
+    
+    Uint64 getFrame()
+    {
+        return mFrame;
+    }
+    
+    void beginFrame()
+    {
+        PROFILE_ZONE("TextureResidency::beginFrame")
+        
+        mFrame++;
+        
+        PROFILE_COUNTER("Resident texture bytes", mResidentBytes)
+        
+        if (mBudget == UNLIMITED_BUDGET || mResidentBytes <= mBudget)
+        {
+            mWorkingSetWarned = false;
+            
+            return;
+        }
+        
+        // Evicting changes the resident list, so the candidates are copied out first
+        TextureAsset **candidates = FrameMemory::getArena().allocateArray<TextureAsset*>(mResidentTextures.size());
+        TextureAsset **candidatesEnd = candidates;
+        
+        // Textures drawn last frame are almost certainly drawn again this frame, evicting them would only
+        // trade the budget for a reload every frame
+        for (TextureAsset *texture : mResidentTextures)
+        {
+            if (texture->isEvictable() && texture->getLastUsedFrame() + 1 < mFrame)
+                *candidatesEnd++ = texture;
+        }
+        
+        std::sort(candidates, candidatesEnd, [](TextureAsset *a, TextureAsset *b)
+        {
+            return a->getLastUsedFrame() < b->getLastUsedFrame();
+        });
+        
+        for (TextureAsset **texture = candidates; texture != candidatesEnd && mResidentBytes > mBudget; texture++)
+        {
+            (*texture)->evict();
+            
+            mEvictionCount++;
+        }
+        
+        if (mResidentBytes > mBudget && !mWorkingSetWarned)
+        {
+            LOG_MESSAGE(Warning, "Textures in use need %zu bytes, over the %zu byte texture budget!", mResidentBytes, mBudget)
+            
+            mWorkingSetWarned = true;
+        }
+    }
+    
+    void recordReload()
+    {
+        mReloadCount++;
+    }
+    
+    size_t getResidentBytes()
+    {
+        return mResidentBytes;
+    }
+    
+    int getResidentCount()
+    {
+        return static_cast<int>(mResidentTextures.size());
+    }
+    
+    int getEvictionCount()
+    {
+        return mEvictionCount;
+    }
+    
+    int getReloadCount()
+    {
+        return mReloadCount;
+    }
+}
@@ -0,0 +1,60 @@
+//
+//  textureResidency.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef textureResidency_hpp
+#define textureResidency_hpp
+
+#include <SDL.h>
+#include <stdio.h>
+
+class TextureAsset;
+
+// Keeps the texture memory held by texture assets under a budget, main thread only
+namespace TextureResidency
+{
+    // A budget of zero never evicts anything
+    const size_t UNLIMITED_BUDGET = 0;
+    
+    // Sets how many bytes of texture memory may stay resident before textures are evicted
+    void setBudget(size_t bytes);
+    
+    // Returns the current budget in bytes
+    size_t getBudget();
+    
+    // Returns how many bytes of video memory the texture takes up
+    size_t calculateByteSize(SDL_Texture *texture);
+    
+    // Starts counting a texture that has just been created or reloaded
+    void track(TextureAsset *texture);
+    
+    // Stops counting a texture that is about to be destroyed or evicted
+    void untrack(TextureAsset *texture);
+    
+    // Returns the number of the current frame, textures stamp it whenever they are used
+    Uint64 getFrame();
+    
+    // Advances the frame and evicts the least recently used textures until the budget is met again
+    void beginFrame();
+    
+    // Counts a reload of an evicted texture
+    void recordReload();
+    
+    // Returns the bytes of texture memory currently resident
+    size_t getResidentBytes();
+    
+    // Returns the number of textures currently resident
+    int getResidentCount();
+    
+    // Returns the number of textures evicted since startup
+    int getEvictionCount();
+    
+    // Returns the number of evicted textures reloaded since startup
+    int getReloadCount();
+}
+
+#endif /* textureResidency_hpp */
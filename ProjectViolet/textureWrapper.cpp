@@ -7,11 +7,11 @@
 //
 
 #include "debug.hpp"
+#include "profiler.hpp"
+#include "textCache.hpp"
 #include "textureWrapper.hpp"
 
-#include <SDL_image.h>
-
-TextureWrapper::TextureWrapper() : mRenderer(nullptr), mWrappedTexture(nullptr, nullptr), mWidth(0), mHeight(0), mXScaleFactor(0.0f), mYScaleFactor(0.0f)
+TextureWrapper::TextureWrapper() : mRenderer(nullptr), mWrappedTexture(nullptr), mPendingTexture(nullptr), mWidth(0), mHeight(0), mSourceRect({0, 0, 0, 0}), mXScaleFactor(0.0f), mYScaleFactor(0.0f), mColorModulation({0xFF, 0xFF, 0xFF, 0xFF}), mBlendMode(SDL_BLENDMODE_NONE)
 {
     
 }
@@ -25,113 +25,144 @@ void TextureWrapper::freeTexture()
 {
     mRenderer = nullptr;
     mWrappedTexture = nullptr;
+    mPendingTexture = nullptr;
     
     mWidth = 0;
     mHeight = 0;
     
+    mSourceRect = {0, 0, 0, 0};
+    
     mXScaleFactor = 0.0f;
     mYScaleFactor = 0.0f;
+    
+    mColorModulation = {0xFF, 0xFF, 0xFF, 0xFF};
+    mBlendMode = SDL_BLENDMODE_NONE;
 }
 
-bool TextureWrapper::initFromFile(std::string filePath, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey)
+bool TextureWrapper::initFromFile(const std::string &filePath, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
 {
+    PROFILE_ZONE("TextureWrapper::initFromFile")
+    
     // Loading success flag
-    bool success = false;
+    bool success = true;
     
     // Releases any attached textures
-    if (mWrappedTexture != nullptr)
+    if (mWrappedTexture != nullptr || mPendingTexture != nullptr)
         freeTexture();
     
     // Pass the application's renderer to the texture
     mRenderer = renderer;
     
-    // Loads the image as a SDL surface
-    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loadedSurface(IMG_Load(filePath.c_str()), &SDL_FreeSurface);
+    // Fetch the shared texture, the asset manager only decodes the image the first time it is requested
+    mWrappedTexture = AssetManager::loadTexture(filePath, mRenderer, colorKeyImage, colorKey, pixelFormat);
     
-    // Check if it loads successfully
-    if (!loadedSurface)
+    // Check if its loaded successfully, the asset manager has already logged the reason
+    if (!mWrappedTexture)
     {
-        ON_DEBUG(Debug::logMessage("Failed to load image from " + filePath + "!", SevereError, __LINE__, __FILE_NAME__);)
-        ON_DEBUG(Debug::logMessage(IMG_GetError(), SDLImageError, __LINE__, __FILE_NAME__);)
-        
         success = false;
     }
     else
     {
-        // Color keys the image if enabled
-        if (colorKeyImage)
-            SDL_SetColorKey(loadedSurface.get(), SDL_TRUE, SDL_MapRGB(loadedSurface->format, colorKey.r, colorKey.g, colorKey.b));
-        
-        // Attaches the 
-        mWrappedTexture = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(SDL_CreateTextureFromSurface(mRenderer.get(), loadedSurface.get()), &SDL_DestroyTexture);
-        
-        // Check if its loaded successfully
-        if (!mWrappedTexture)
-        {
-            ON_DEBUG(Debug::logMessage("Failed to convert " + filePath + " into a texture!", SevereError, __LINE__, __FILE_NAME__);)
-            ON_DEBUG(Debug::logMessage(SDL_GetError(), SDLError, __LINE__, __FILE_NAME__);)
-            
-            success = false;
-        }
-        else
-        {
-            // Preserve the texture's dimensions
-            mWidth = loadedSurface->w;
-            mHeight = loadedSurface->h;
-            
-            // Store the texture scale resizing the render quad in TextureWrapper::render(...)
-            mXScaleFactor = imageXScale;
-            mYScaleFactor = imageYScale;
-        }
+        // Preserve the texture's dimensions
+        mWidth = mWrappedTexture->getWidth();
+        mHeight = mWrappedTexture->getHeight();
+        
+        mSourceRect = {0, 0, mWidth, mHeight};
+        
+        // Store the texture scale resizing the render quad in TextureWrapper::render(...)
+        mXScaleFactor = imageXScale;
+        mYScaleFactor = imageYScale;
+        
+        // Start from the blend mode SDL picked for the image
+        SDL_GetTextureBlendMode(mWrappedTexture->getTexture(), &mBlendMode);
     }
     
     return success;
 }
 
-bool TextureWrapper::initFromString(std::string text, std::shared_ptr<TTF_Font> &textFont, SDL_Color textColor, std::shared_ptr<SDL_Renderer> &renderer)
+bool TextureWrapper::initFromFileAsync(AssetLoader &assetLoader, const std::string &filePath, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage, SDL_Color colorKey, Uint32 pixelFormat)
+{
+    PROFILE_ZONE("TextureWrapper::initFromFileAsync")
+    
+    // Releases any attached textures
+    if (mWrappedTexture != nullptr || mPendingTexture != nullptr)
+        freeTexture();
+    
+    // Pass the application's renderer to the texture
+    mRenderer = renderer;
+    
+    // The scale is known now, the dimensions only once the image has been decoded
+    mXScaleFactor = imageXScale;
+    mYScaleFactor = imageYScale;
+    
+    mPendingTexture = assetLoader.loadTextureAsync(filePath, colorKeyImage, colorKey, pixelFormat);
+    
+    // Cached textures are ready straight away
+    attachLoadedTexture();
+    
+    return true;
+}
+
+bool TextureWrapper::isLoaded()
+{
+    attachLoadedTexture();
+    
+    return mWrappedTexture != nullptr;
+}
+
+void TextureWrapper::attachLoadedTexture()
 {
+    if (!mPendingTexture || !mPendingTexture->isFinished())
+        return;
+    
+    mWrappedTexture = mPendingTexture->getTexture();
+    mPendingTexture = nullptr;
+    
+    // The loader has already logged why a failed load failed
+    if (mWrappedTexture)
+    {
+        mWidth = mWrappedTexture->getWidth();
+        mHeight = mWrappedTexture->getHeight();
+        
+        mSourceRect = {0, 0, mWidth, mHeight};
+        
+        SDL_GetTextureBlendMode(mWrappedTexture->getTexture(), &mBlendMode);
+    }
+}
+
+bool TextureWrapper::initFromString(const std::string &text, std::shared_ptr<TTF_Font> &textFont, SDL_Color textColor, std::shared_ptr<SDL_Renderer> &renderer, Uint32 wrapWidth)
+{
+    PROFILE_ZONE("TextureWrapper::initFromString")
+    
     // Loading success flag
     bool success = true;
     
     // Release any texture previously attached to the wrapper
-    if (!mWrappedTexture)
+    if (mWrappedTexture != nullptr || mPendingTexture != nullptr)
         freeTexture();
     
     // Attach the renderer to the texture
     mRenderer = renderer;
     
-    // Create a surface containing text using TTF
-    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> loadedSurface(TTF_RenderText_Blended_Wrapped(textFont.get(), text.c_str(), textColor, 300 * 1.776), &SDL_FreeSurface);
+    // Labels with the same text, font, color and wrap width share one texture, only new ones are rasterized
+    mWrappedTexture = TextCache::renderText(text, textFont, textColor, wrapWidth, mRenderer);
     
-    // Check if it was loaded successfully
-    if (!loadedSurface)
+    // Check if it was rendered successfully, the text cache has already logged the reason
+    if (!mWrappedTexture)
     {
-        ON_DEBUG(Debug::logMessage("Unable to render text to a surface!", SevereError, __LINE__, __FILE_NAME__);)
-        ON_DEBUG(Debug::logMessage(TTF_GetError(), SDLFontError, __LINE__, __FILE_NAME__);)
-        
         success = false;
     }
     else
     {
-        // Convert the surface to a texture
-        mWrappedTexture = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(SDL_CreateTextureFromSurface(mRenderer.get(), loadedSurface.get()), &SDL_DestroyTexture);
-        
-        // Check if the conversion was successful
-        if (!mWrappedTexture)
-        {
-            ON_DEBUG(Debug::logMessage("Unable to convert the rendered text to a texture!", SevereError, __LINE__, __FILE_NAME__);)
-            ON_DEBUG(Debug::logMessage(SDL_GetError(), SDLError, __LINE__, __FILE_NAME__);)
-            
-            success = false;
-        }
-        else
-        {
-            mWidth = loadedSurface->w;
-            mHeight = loadedSurface->h;
-            
-            mXScaleFactor = 1;
-            mYScaleFactor = 1;
-        }
+        mWidth = mWrappedTexture->getWidth();
+        mHeight = mWrappedTexture->getHeight();
+        
+        mSourceRect = {0, 0, mWidth, mHeight};
+        
+        mXScaleFactor = 1;
+        mYScaleFactor = 1;
+        
+        SDL_GetTextureBlendMode(mWrappedTexture->getTexture(), &mBlendMode);
     }
     
     return success;
@@ -139,40 +170,46 @@ bool TextureWrapper::initFromString(std::string text, std::shared_ptr<TTF_Font>
 
 bool TextureWrapper::initFromRectangle(SDL_Rect baseRectangle, SDL_Color rectangleColor, std::shared_ptr<SDL_Renderer> &renderer)
 {
+    PROFILE_ZONE("TextureWrapper::initFromRectangle")
+    
     // Loading success flag
     bool success = true;
     
     // Release any previously attached textures
-    if (!mWrappedTexture)
+    if (mWrappedTexture != nullptr || mPendingTexture != nullptr)
         freeTexture();
     
     // Attach the renderer to the texture
     mRenderer = renderer;
     
     // Create a targetable texture
-    mWrappedTexture = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(SDL_CreateTexture(mRenderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, baseRectangle.w, baseRectangle.h), &SDL_DestroyTexture);
+    SDL_Texture *texture = SDL_CreateTexture(mRenderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, baseRectangle.w, baseRectangle.h);
     
     // Check if it was created successfully
-    if (!mWrappedTexture)
+    if (texture == nullptr)
     {
-        ON_DEBUG(Debug::logMessage("Failed to create a targetable texture!", SevereError, __LINE__, __FILE_NAME__);)
-        ON_DEBUG(Debug::logMessage(SDL_GetError(), SDLError, __LINE__, __FILE_NAME__);)
+        LOG_MESSAGE(SevereError, "Failed to create a targetable texture!")
+        LOG_MESSAGE(SDLError, "%s", SDL_GetError())
         
         success = false;
     }
     else
     {
+        mWrappedTexture = std::make_shared<TextureAsset>(texture, baseRectangle.w, baseRectangle.h);
+        
         // Set the dimensions
         mWidth = baseRectangle.w;
         mHeight = baseRectangle.h;
         
+        mSourceRect = {0, 0, mWidth, mHeight};
+        
         // Set the scale
         mXScaleFactor = 1;
         mYScaleFactor = 1;
         
         // Make the texture the color of the rectangle:
         // 1) Target the texture
-        SDL_SetRenderTarget(mRenderer.get(), mWrappedTexture.get());
+        SDL_SetRenderTarget(mRenderer.get(), texture);
         // 2) Set the render draw color to the color of the rectanlge
         SDL_SetRenderDrawColor(mRenderer.get(), rectangleColor.r, rectangleColor.g, rectangleColor.b, rectangleColor.a);
         // 3) Paint the screen by "clearing" it
@@ -186,9 +223,50 @@ bool TextureWrapper::initFromRectangle(SDL_Rect baseRectangle, SDL_Color rectang
     return success;
 }
 
-void TextureWrapper::render(int x, int y, bool fixed, SDL_Rect camera, std::unique_ptr<SDL_Rect> clipRect, double angle, std::unique_ptr<SDL_Point> center, SDL_RendererFlip flip)
+bool TextureWrapper::initFromAtlas(TextureAtlas &atlas, const std::string &imageName, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer)
 {
-    SDL_Rect renderQuad {x, y, mWidth, mHeight};
+    PROFILE_ZONE("TextureWrapper::initFromAtlas")
+    
+    // Loading success flag
+    bool success = true;
+    
+    // Releases any attached textures
+    if (mWrappedTexture != nullptr || mPendingTexture != nullptr)
+        freeTexture();
+    
+    // Pass the application's renderer to the texture
+    mRenderer = renderer;
+    
+    AtlasRegion region;
+    
+    // Check if the image was packed into the atlas
+    if (!atlas.findRegion(imageName, region) || !(mWrappedTexture = atlas.getPage(region.page)))
+    {
+        LOG_MESSAGE(SevereError, "Failed to find %s in the texture atlas!", imageName.c_str())
+        
+        success = false;
+    }
+    else
+    {
+        // The wrapper only shows its own part of the shared atlas page
+        mSourceRect = region.rect;
+        
+        mWidth = region.rect.w;
+        mHeight = region.rect.h;
+        
+        mXScaleFactor = imageXScale;
+        mYScaleFactor = imageYScale;
+        
+        mBlendMode = SDL_BLENDMODE_BLEND;
+    }
+    
+    return success;
+}
+
+void TextureWrapper::computeRenderRects(int x, int y, bool fixed, const SDL_Rect &camera, const SDL_Rect *clipRect, SDL_Rect &sourceRect, SDL_Rect &renderQuad)
+{
+    renderQuad = {x, y, mWidth, mHeight};
+    sourceRect = mSourceRect;
     
     // Adjust the texture based off a camera variable if true
     if (!fixed)
@@ -197,28 +275,98 @@ void TextureWrapper::render(int x, int y, bool fixed, SDL_Rect camera, std::uniq
         renderQuad.y -= camera.y;
     }
     
-    // Applies the clip dimensions if a clip rectangle is passed
+    // Applies the clip dimensions if a clip rectangle is passed, the clip is relative to the wrapper's own image
     if (clipRect)
     {
         renderQuad.w = clipRect->w;
         renderQuad.h = clipRect->h;
+        
+        sourceRect = {mSourceRect.x + clipRect->x, mSourceRect.y + clipRect->y, clipRect->w, clipRect->h};
     }
     
     renderQuad.x *= mXScaleFactor;
     renderQuad.y *= mYScaleFactor;
+}
+
+void TextureWrapper::render(int x, int y, bool fixed, SDL_Rect camera, const SDL_Rect *clipRect, double angle, const SDL_Point *center, SDL_RendererFlip flip)
+{
+    PROFILE_ZONE("TextureWrapper::render")
+    
+    DrawCommand command;
+    
+    // Nothing to draw until a texture has been attached
+    if (!makeDrawCommand(command, x, y, 0, fixed, camera, clipRect, angle, center, flip))
+        return;
+    
+    // The texture may be shared, so this wrapper's color and blend state is applied right before drawing
+    SDL_SetTextureBlendMode(command.texture, command.blendMode);
+    SDL_SetTextureColorMod(command.texture, command.colorModulation.r, command.colorModulation.g, command.colorModulation.b);
+    SDL_SetTextureAlphaMod(command.texture, command.colorModulation.a);
+    
+    SDL_RenderCopyEx(mRenderer.get(), command.texture, &command.source, &command.destination, angle, center, flip);
+}
+
+bool TextureWrapper::makeDrawCommand(DrawCommand &command, int x, int y, int layer, bool fixed, SDL_Rect camera, const SDL_Rect *clipRect, double angle, const SDL_Point *center, SDL_RendererFlip flip)
+{
+    // Pick up a background load that finished since the last frame
+    if (mPendingTexture)
+        attachLoadedTexture();
+    
+    if (!mWrappedTexture)
+        return false;
+    
+    computeRenderRects(x, y, fixed, camera, clipRect, command.source, command.destination);
+    
+    command.texture = mWrappedTexture->getTexture();
+    command.angle = angle;
+    command.center = center != nullptr ? *center : SDL_Point {0, 0};
+    command.hasCenter = center != nullptr;
+    command.flip = flip;
+    command.colorModulation = mColorModulation;
+    command.blendMode = mBlendMode;
+    command.layer = layer;
+    
+    return true;
+}
+
+void TextureWrapper::queue(RenderQueue &renderQueue, int x, int y, int layer, bool fixed, SDL_Rect camera, const SDL_Rect *clipRect, double angle, const SDL_Point *center, SDL_RendererFlip flip)
+{
+    DrawCommand command;
+    
+    if (makeDrawCommand(command, x, y, layer, fixed, camera, clipRect, angle, center, flip))
+        renderQueue.submit(command);
+}
+
+void TextureWrapper::renderBatched(SpriteBatch &spriteBatch, int x, int y, bool fixed, SDL_Rect camera, const SDL_Rect *clipRect, double angle, SDL_RendererFlip flip)
+{
+    PROFILE_ZONE("TextureWrapper::renderBatched")
+    
+    // Pick up a background load that finished since the last frame
+    if (mPendingTexture)
+        attachLoadedTexture();
+    
+    // Nothing to draw until a texture has been attached
+    if (!mWrappedTexture)
+        return;
+    
+    SDL_Rect sourceRect, renderQuad;
+    
+    computeRenderRects(x, y, fixed, camera, clipRect, sourceRect, renderQuad);
+    
+    SDL_FRect destination {static_cast<float>(renderQuad.x), static_cast<float>(renderQuad.y), static_cast<float>(renderQuad.w), static_cast<float>(renderQuad.h)};
     
-    SDL_RenderCopyEx(mRenderer.get(), mWrappedTexture.get(), clipRect.get(), &renderQuad, angle, center.get(), flip);
+    // Color modulation and blend mode travel with the quad, the batch sets the mode once per batch when it is drawn
+    spriteBatch.draw(mWrappedTexture->getTexture(), mWrappedTexture->getWidth(), mWrappedTexture->getHeight(), sourceRect, destination, angle, flip, mColorModulation, mBlendMode);
 }
 
 void TextureWrapper::setBlendMode(SDL_BlendMode blendMode)
 {
-    SDL_SetTextureBlendMode(mWrappedTexture.get(), blendMode);
+    mBlendMode = blendMode;
 }
 
 void TextureWrapper::modifyTextureColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
-    SDL_SetTextureColorMod(mWrappedTexture.get(), r, g, b);
-    SDL_SetTextureAlphaMod(mWrappedTexture.get(), a);
+    mColorModulation = {r, g, b, a};
 }
 
 void TextureWrapper::setTextureScale(double xScaleFactor, double yScaleFactor)
@@ -15,6 +15,12 @@
 #include <stdio.h>
 #include <string>
 
+#include "assetLoader.hpp"
+#include "assetManager.hpp"
+#include "renderQueue.hpp"
+#include "spriteBatch.hpp"
+#include "textureAtlas.hpp"
+
 class TextureWrapper
 {
 public:
@@ -24,17 +30,35 @@ public:
     // Calls for the attached texture to be freed
     ~TextureWrapper();
     
-    // Creates a texture from a file and attaches it to the wrapper
-    bool initFromFile(std::string filePath, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage = false, SDL_Color colorKey = {0xFF, 0x00, 0xDC});
+    // Attaches the shared texture for a file to the wrapper, only loading the file if no other wrapper uses it
+    bool initFromFile(const std::string &filePath, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage = false, SDL_Color colorKey = {0xFF, 0x00, 0xDC}, Uint32 pixelFormat = SDL_PIXELFORMAT_UNKNOWN);
+    
+    // Queues a file for background loading, the wrapper draws nothing until the texture has been uploaded
+    bool initFromFileAsync(AssetLoader &assetLoader, const std::string &filePath, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer, bool colorKeyImage = false, SDL_Color colorKey = {0xFF, 0x00, 0xDC}, Uint32 pixelFormat = SDL_PIXELFORMAT_UNKNOWN);
     
-    // Creates a texture from a string and attaches it to the wrapper
-    bool initFromString(std::string text, std::shared_ptr<TTF_Font> &textFont, SDL_Color textColor, std::shared_ptr<SDL_Renderer> &renderer);
+    // Returns whether a texture is attached, picking up a finished background load if there is one
+    bool isLoaded();
+    
+    // Attaches a texture of the string, wrapped at wrapWidth pixels, reusing the texture of an identical label if one is cached
+    bool initFromString(const std::string &text, std::shared_ptr<TTF_Font> &textFont, SDL_Color textColor, std::shared_ptr<SDL_Renderer> &renderer, Uint32 wrapWidth = DEFAULT_TEXT_WRAP_WIDTH);
     
     // Creates a texture from a SDL rectangle and attaches it to the wrapper
     bool initFromRectangle(SDL_Rect baseRectangle, SDL_Color rectangleColor, std::shared_ptr<SDL_Renderer> &renderer);
     
+    // Attaches an image packed into an atlas to the wrapper
+    bool initFromAtlas(TextureAtlas &atlas, const std::string &imageName, double imageXScale, double imageYScale, std::shared_ptr<SDL_Renderer> &renderer);
+    
     // Uses the SDL renderer to render the texture to the screen
-    void render(int x, int y, bool fixed = false, SDL_Rect camera = {0, 0, 0, 0}, std::unique_ptr<SDL_Rect> clipRect = nullptr, double angle = 0.0f, std::unique_ptr<SDL_Point> center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    void render(int x, int y, bool fixed = false, SDL_Rect camera = {0, 0, 0, 0}, const SDL_Rect *clipRect = nullptr, double angle = 0.0f, const SDL_Point *center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    
+    // Builds the draw command render(...) would execute, carrying this wrapper's color and blend state
+    bool makeDrawCommand(DrawCommand &command, int x, int y, int layer = 0, bool fixed = false, SDL_Rect camera = {0, 0, 0, 0}, const SDL_Rect *clipRect = nullptr, double angle = 0.0f, const SDL_Point *center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    
+    // Records the texture in a render queue to be drawn sorted with the rest of the frame
+    void queue(RenderQueue &renderQueue, int x, int y, int layer = 0, bool fixed = false, SDL_Rect camera = {0, 0, 0, 0}, const SDL_Rect *clipRect = nullptr, double angle = 0.0f, const SDL_Point *center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    
+    // Queues the texture in a sprite batch instead of drawing it immediately, rotation is always about the center
+    void renderBatched(SpriteBatch &spriteBatch, int x, int y, bool fixed = false, SDL_Rect camera = {0, 0, 0, 0}, const SDL_Rect *clipRect = nullptr, double angle = 0.0f, SDL_RendererFlip flip = SDL_FLIP_NONE);
     
     // Allows one to enable the alpha channel
     void setBlendMode(SDL_BlendMode blendMode);
@@ -57,21 +81,40 @@ public:
     // Returns the texture's scaled height
     int getScaledHeight();
     
+    // Width text wraps at when no other is given, the width labels were always wrapped at
+    static const Uint32 DEFAULT_TEXT_WRAP_WIDTH = 532;
+    
 private:
     // Frees the attached texture to allow new textures to be attached
     void freeTexture();
     
+    // Attaches the texture of a finished background load
+    void attachLoadedTexture();
+    
+    // Works out where the texture lands on screen and which part of the wrapped texture it shows
+    void computeRenderRects(int x, int y, bool fixed, const SDL_Rect &camera, const SDL_Rect *clipRect, SDL_Rect &sourceRect, SDL_Rect &renderQuad);
+    
     // Pointer to the renderer so that it doesn't have to be repeatedly passed to the texture
     std::shared_ptr<SDL_Renderer> mRenderer;
     
-    // The SDL texure being wrapped
-    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> mWrappedTexture;
+    // The SDL texure being wrapped, possibly shared with other wrappers
+    std::shared_ptr<TextureAsset> mWrappedTexture;
+    
+    // Background load the wrapper is waiting on, if any
+    std::shared_ptr<TextureRequest> mPendingTexture;
     
     // Texture's dimensions, has to be stored because they're lost when the SDL surface is converted to a texture
     int mWidth, mHeight;
     
+    // The part of the wrapped texture this wrapper shows, anything but the whole texture for atlas images
+    SDL_Rect mSourceRect;
+    
     // Texture's x and y scale factor
     double mXScaleFactor, mYScaleFactor;
+    
+    // Per-wrapper color and blend state, applied at render time since the texture itself may be shared
+    SDL_Color mColorModulation;
+    SDL_BlendMode mBlendMode;
 };
 
 #endif /* textureWrapper_hpp */
@@ -0,0 +1,269 @@
+//
+//  tileMap.cpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#include "debug.hpp"
+#include "pixelConversion.hpp"
+#include "profiler.hpp"
+#include "tileMap.hpp"
+
+#include <algorithm>
+
+TileMap::TileMap(int chunkTiles) : mChunkTiles(chunkTiles > 0 ? chunkTiles : 16), mWidthTiles(0), mHeightTiles(0), mTileSize(0), mChunkColumns(0), mChunkRows(0), mTilesetColumns(0), mTileset(nullptr), mRenderer(nullptr), mPremultipliedChunks(true), mLastChunkDrawCount(0), mLastBakeCount(0)
+{
+    
+}
+
+bool TileMap::init(int widthTiles, int heightTiles, int tileSize, std::shared_ptr<TextureAsset> tileset, std::shared_ptr<SDL_Renderer> &renderer)
+{
+    PROFILE_ZONE("TileMap::init")
+    
+    if (widthTiles <= 0 || heightTiles <= 0 || tileSize <= 0 || !tileset || tileset->getWidth() < tileSize)
+    {
+        LOG_MESSAGE(SevereError, "Invalid tile map of %dx%d tiles with a tile size of %d!", widthTiles, heightTiles, tileSize)
+        
+        return false;
+    }
+    
+    // Only renderers that can draw into textures can bake chunks
+    SDL_RendererInfo info;
+    
+    if (SDL_GetRendererInfo(renderer.get(), &info) != 0 || !(info.flags & SDL_RENDERER_TARGETTEXTURE))
+    {
+        LOG_MESSAGE(SevereError, "The renderer does not support target textures, tile maps can't be baked!")
+        
+        return false;
+    }
+    
+    mWidthTiles = widthTiles;
+    mHeightTiles = heightTiles;
+    mTileSize = tileSize;
+    mTilesetColumns = tileset->getWidth() / tileSize;
+    
+    mTileset = tileset;
+    mRenderer = renderer;
+    
+    mTiles.assign(static_cast<size_t>(widthTiles) * heightTiles, EMPTY_TILE);
+    
+    mChunkColumns = (widthTiles + mChunkTiles - 1) / mChunkTiles;
+    mChunkRows = (heightTiles + mChunkTiles - 1) / mChunkTiles;
+    
+    // Chunk textures are only created once a chunk is first seen
+    mChunks.clear();
+    mChunks.reserve(static_cast<size_t>(mChunkColumns) * mChunkRows);
+    
+    for (int chunkY = 0; chunkY < mChunkRows; chunkY++)
+    {
+        for (int chunkX = 0; chunkX < mChunkColumns; chunkX++)
+        {
+            int width = std::min(mChunkTiles, widthTiles - chunkX * mChunkTiles) * tileSize;
+            int height = std::min(mChunkTiles, heightTiles - chunkY * mChunkTiles) * tileSize;
+            
+            mChunks.push_back({std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>(nullptr, SDL_DestroyTexture), width, height, true});
+        }
+    }
+    
+    return true;
+}
+
+void TileMap::free()
+{
+    mChunks.clear();
+    mTiles.clear();
+    
+    mTileset = nullptr;
+    mRenderer = nullptr;
+    
+    mWidthTiles = mHeightTiles = 0;
+    mChunkColumns = mChunkRows = 0;
+}
+
+void TileMap::setTile(int x, int y, int tile)
+{
+    if (x < 0 || y < 0 || x >= mWidthTiles || y >= mHeightTiles)
+        return;
+    
+    int &current = mTiles[static_cast<size_t>(y) * mWidthTiles + x];
+    
+    // Writing the same tile again shouldn't cost a bake
+    if (current == tile)
+        return;
+    
+    current = tile;
+    
+    mChunks[(y / mChunkTiles) * mChunkColumns + x / mChunkTiles].dirty = true;
+}
+
+int TileMap::getTile(int x, int y)
+{
+    if (x < 0 || y < 0 || x >= mWidthTiles || y >= mHeightTiles)
+        return EMPTY_TILE;
+    
+    return mTiles[static_cast<size_t>(y) * mWidthTiles + x];
+}
+
+bool TileMap::bakeChunk(int chunkX, int chunkY)
+{
+    PROFILE_ZONE("TileMap::bakeChunk")
+    
+    Chunk &chunk = mChunks[chunkY * mChunkColumns + chunkX];
+    
+    if (!chunk.texture)
+    {
+        chunk.texture.reset(SDL_CreateTexture(mRenderer.get(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, chunk.width, chunk.height));
+        
+        if (!chunk.texture)
+        {
+            LOG_MESSAGE(SevereError, "Failed to create a %dx%d chunk texture!", chunk.width, chunk.height)
+            LOG_MESSAGE(SDLError, "%s", SDL_GetError())
+            
+            return false;
+        }
+        
+        // Empty tiles stay see-through so layers can be stacked, blending tiles onto the transparent chunk leaves its
+        // colors premultiplied by alpha whether or not the tileset's were, so it is drawn premultiplied
+        if (mPremultipliedChunks && SDL_SetTextureBlendMode(chunk.texture.get(), PixelConversion::getPremultipliedBlendMode()) != 0)
+        {
+            LOG_MESSAGE(Warning, "The renderer has no premultiplied blending, tile chunks will be baked unblended instead!")
+            
+            mPremultipliedChunks = false;
+        }
+        
+        if (!mPremultipliedChunks)
+            SDL_SetTextureBlendMode(chunk.texture.get(), SDL_BLENDMODE_BLEND);
+    }
+    
+    SDL_Texture *tilesetTexture = mTileset->getTexture();
+    
+    // Tiles never overlap within a chunk, so copying them unblended keeps the tileset's own alpha for plain blending
+    SDL_BlendMode tilesetBlendMode = SDL_BLENDMODE_BLEND;
+    
+    if (!mPremultipliedChunks)
+    {
+        SDL_GetTextureBlendMode(tilesetTexture, &tilesetBlendMode);
+        SDL_SetTextureBlendMode(tilesetTexture, SDL_BLENDMODE_NONE);
+    }
+    
+    // Whatever the frame is being drawn into is put back afterwards
+    SDL_Texture *previousTarget = SDL_GetRenderTarget(mRenderer.get());
+    
+    SDL_SetRenderTarget(mRenderer.get(), chunk.texture.get());
+    SDL_SetRenderDrawColor(mRenderer.get(), 0x00, 0x00, 0x00, 0x00);
+    SDL_RenderClear(mRenderer.get());
+    
+    int firstX = chunkX * mChunkTiles;
+    int firstY = chunkY * mChunkTiles;
+    int lastX = std::min(firstX + mChunkTiles, mWidthTiles);
+    int lastY = std::min(firstY + mChunkTiles, mHeightTiles);
+    
+    for (int y = firstY; y < lastY; y++)
+    {
+        for (int x = firstX; x < lastX; x++)
+        {
+            int tile = mTiles[static_cast<size_t>(y) * mWidthTiles + x];
+            
+            if (tile == EMPTY_TILE)
+                continue;
+            
+            SDL_Rect source = {(tile % mTilesetColumns) * mTileSize, (tile / mTilesetColumns) * mTileSize, mTileSize, mTileSize};
+            SDL_Rect destination = {(x - firstX) * mTileSize, (y - firstY) * mTileSize, mTileSize, mTileSize};
+            
+            SDL_RenderCopy(mRenderer.get(), tilesetTexture, &source, &destination);
+        }
+    }
+    
+    if (!mPremultipliedChunks)
+        SDL_SetTextureBlendMode(tilesetTexture, tilesetBlendMode);
+    
+    SDL_SetRenderDrawColor(mRenderer.get(), 0xFF, 0xFF, 0xFF, 0xFF);
+    SDL_SetRenderTarget(mRenderer.get(), previousTarget);
+    
+    chunk.dirty = false;
+    
+    return true;
+}
+
+void TileMap::queue(RenderQueue &renderQueue, SDL_Rect camera, int layer)
+{
+    PROFILE_ZONE("TileMap::queue")
+    
+    mLastChunkDrawCount = 0;
+    mLastBakeCount = 0;
+    
+    if (!isLoaded())
+        return;
+    
+    // Nothing to draw when the camera is entirely above or left of the map
+    if (camera.x + camera.w <= 0 || camera.y + camera.h <= 0)
+        return;
+    
+    // Range of chunks the camera overlaps, clamped to the map
+    int chunkPixels = mChunkTiles * mTileSize;
+    
+    int firstX = std::max(camera.x, 0) / chunkPixels;
+    int firstY = std::max(camera.y, 0) / chunkPixels;
+    int lastX = std::min((camera.x + camera.w - 1) / chunkPixels, mChunkColumns - 1);
+    int lastY = std::min((camera.y + camera.h - 1) / chunkPixels, mChunkRows - 1);
+    
+    for (int chunkY = firstY; chunkY <= lastY; chunkY++)
+    {
+        for (int chunkX = firstX; chunkX <= lastX; chunkX++)
+        {
+            Chunk &chunk = mChunks[chunkY * mChunkColumns + chunkX];
+            
+            // Chunks off screen stay dirty until they are needed
+            if (chunk.dirty)
+            {
+                if (!bakeChunk(chunkX, chunkY))
+                    continue;
+                
+                mLastBakeCount++;
+            }
+            
+            DrawCommand command;
+            
+            command.texture = chunk.texture.get();
+            command.source = {0, 0, chunk.width, chunk.height};
+            command.destination = {chunkX * chunkPixels - camera.x, chunkY * chunkPixels - camera.y, chunk.width, chunk.height};
+            command.angle = 0.0;
+            command.center = {0, 0};
+            command.hasCenter = false;
+            command.flip = SDL_FLIP_NONE;
+            command.colorModulation = {0xFF, 0xFF, 0xFF, 0xFF};
+            command.blendMode = mPremultipliedChunks ? PixelConversion::getPremultipliedBlendMode() : SDL_BLENDMODE_BLEND;
+            command.layer = layer;
+            
+            renderQueue.submit(command);
+            
+            mLastChunkDrawCount++;
+        }
+    }
+    
+    PROFILE_COUNTER("Tile chunks drawn", mLastChunkDrawCount)
+    PROFILE_COUNTER("Tile chunks baked", mLastBakeCount)
+}
+
+void TileMap::invalidateChunks()
+{
+    for (Chunk &chunk : mChunks)
+        chunk.dirty = true;
+}
+
+int TileMap::getLastChunkDrawCount()
+{
+    return mLastChunkDrawCount;
+}
+
+int TileMap::getLastBakeCount()
+{
+    return mLastBakeCount;
+}
+
+bool TileMap::isLoaded()
+{
+    return mTileset != nullptr && !mChunks.empty();
+}
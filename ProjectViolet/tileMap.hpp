@@ -0,0 +1,94 @@
+//
+//  tileMap.hpp
+//  ProjectViolet
+//
+//  Created by Keegan Bilodeau on 10/17/26.
+//  Copyright © 2026 Keegan Bilodeau. All rights reserved.
+//
+
+#ifndef tileMap_hpp
+#define tileMap_hpp
+
+#include <memory>
+#include <SDL.h>
+#include <stdio.h>
+#include <vector>
+
+#include "assetManager.hpp"
+#include "renderQueue.hpp"
+
+// One static layer of tiles, baked into chunk textures so drawing it costs one copy per visible chunk
+class TileMap
+{
+public:
+    // Tile value for a cell with nothing drawn in it
+    static const int EMPTY_TILE = -1;
+    
+    // Initializes an empty map, chunks are chunkTiles by chunkTiles tiles
+    TileMap(int chunkTiles = 16);
+    
+    // Sizes the map and sets its tileset, a grid of tileSize squares numbered left to right then top to bottom
+    bool init(int widthTiles, int heightTiles, int tileSize, std::shared_ptr<TextureAsset> tileset, std::shared_ptr<SDL_Renderer> &renderer);
+    
+    // Releases the chunk textures, tileset and renderer
+    void free();
+    
+    // Changes a tile, its chunk is re-baked the next time it is visible
+    void setTile(int x, int y, int tile);
+    
+    // Returns the tile at a cell, or EMPTY_TILE outside the map
+    int getTile(int x, int y);
+    
+    // Bakes any dirty chunks overlapping the camera and records a draw command for each of them
+    void queue(RenderQueue &renderQueue, SDL_Rect camera, int layer);
+    
+    // Marks every chunk for re-baking, needed when the renderer loses its target textures
+    void invalidateChunks();
+    
+    // Returns the number of chunks drawn by the last queue()
+    int getLastChunkDrawCount();
+    
+    // Returns the number of chunks baked by the last queue()
+    int getLastBakeCount();
+    
+    // Returns whether the map has been initialized
+    bool isLoaded();
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture;
+        
+        // Chunk's size in pixels, smaller than a full chunk along the map's right and bottom edges
+        int width, height;
+        
+        bool dirty;
+    };
+    
+    // Renders every tile of the chunk into its texture
+    bool bakeChunk(int chunkX, int chunkY);
+    
+    int mChunkTiles;
+    
+    int mWidthTiles, mHeightTiles, mTileSize;
+    
+    int mChunkColumns, mChunkRows;
+    
+    // Number of tiles per row of the tileset
+    int mTilesetColumns;
+    
+    std::vector<int> mTiles;
+    
+    std::vector<Chunk> mChunks;
+    
+    std::shared_ptr<TextureAsset> mTileset;
+    
+    std::shared_ptr<SDL_Renderer> mRenderer;
+    
+    // Chunks are drawn with premultiplied blending unless the renderer turned it down
+    bool mPremultipliedChunks;
+    
+    int mLastChunkDrawCount, mLastBakeCount;
+};
+
+#endif /* tileMap_hpp */